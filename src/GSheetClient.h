@@ -71,8 +71,14 @@ namespace gsheet
             app.auth_timer.stop();
             app.auth_timer.setInterval(interval);
             app.expire = exp == -1 ? interval : exp;
+            app.refresh_timer.stop();
+            app.auth_data.refreshing = false;
             if (start)
+            {
                 app.auth_timer.start();
+                if (interval > 0)
+                    app.feedRefreshTimer(interval);
+            }
         }
 
     public:
@@ -112,6 +118,16 @@ namespace gsheet
             {
                 app.auth_data.app_token.authenticated = false;
                 uint32_t exp = app.auth_data.user_auth.sa.expire;
+#if defined(GSHEET_ENABLE_SERVICE_AUTH)
+                // Use the saved access token if it is still valid, no token signing and auth request are required.
+                uint32_t ttl = app.loadToken();
+                if (ttl > 0)
+                {
+                    setAuthTsBase(app.aClient, millis());
+                    resetTimer(app, true, ttl, exp);
+                    return;
+                }
+#endif
                 resetTimer(app, true, 0, exp);
             }
             else
@@ -59,6 +59,53 @@
  *
  * 🏷️ For GSheet.printf debug port
  * #define GSHEET_PRINTF_PORT Serial
+ *
+ * 🏷️ For selecting the RSA implementation for JWT signing (ESP8266 always uses GSHEET_JWT_RSA_I15)
+ * GSHEET_JWT_RSA_DEFAULT, GSHEET_JWT_RSA_I15, GSHEET_JWT_RSA_I31, GSHEET_JWT_RSA_I32, GSHEET_JWT_RSA_I62
+ * or GSHEET_JWT_RSA_AUTO to measure all implementations at the first signing and use the fastest one.
+ * #define GSHEET_JWT_RSA_BACKEND GSHEET_JWT_RSA_AUTO
+ *
+ * 🏷️ For JWT signing in FreeRTOS task (ESP32) or worker thread (host build) instead of blocking the auth loop
+ * #define GSHEET_ENABLE_JWT_SIGN_TASK
+ *
+ * 🏷️ For the number of released memory blocks kept in each size class for reuse (0 to disable the pool)
+ * #define GSHEET_MEMORY_POOL_SIZE 4
+ *
+ * 🏷️ For the minimum size of buffers that are placed in PSRAM (ESP32) or external heap (ESP8266)
+ * #define GSHEET_MEMORY_PSRAM_MIN_SIZE 1024
+ *
+ * 🏷️ For GSheetRangeReader, the maximum connections, the target response time (ms) and block size (rows) limits,
+ * and the number of retries of the failed block
+ * #define GSHEET_RANGE_READER_MAX_CONNECTIONS 4
+ * #define GSHEET_RANGE_READER_TARGET_MS 3000
+ * #define GSHEET_RANGE_READER_MIN_ROWS 50
+ * #define GSHEET_RANGE_READER_MAX_ROWS 5000
+ * #define GSHEET_RANGE_READER_MAX_RETRY 2
+ *
+ * 🏷️ For GSheetAppendBuffer, the flush limits (rows, encoded bytes and age in ms), the queue size (bytes)
+ * and the number of retries of the failed batch
+ * #define GSHEET_APPEND_BUFFER_FLUSH_ROWS 50
+ * #define GSHEET_APPEND_BUFFER_FLUSH_BYTES 2048
+ * #define GSHEET_APPEND_BUFFER_FLUSH_MS 10000
+ * #define GSHEET_APPEND_BUFFER_MAX_BYTES 8192
+ * #define GSHEET_APPEND_BUFFER_MAX_RETRY 2
+ *
+ * 🏷️ For GSheetUpdateCoalescer, the coalescing window (ms) and the maximum ranges in one values:batchUpdate
+ * #define GSHEET_UPDATE_COALESCE_WINDOW_MS 200
+ * #define GSHEET_UPDATE_COALESCE_MAX_BATCH 20
+ *
+ * 🏷️ For GSheetReadCoalescer, the coalescing window (ms) and the maximum ranges in one values:batchGet
+ * #define GSHEET_READ_COALESCE_WINDOW_MS 50
+ * #define GSHEET_READ_COALESCE_MAX_BATCH 20
+ *
+ * 🏷️ For GSheetRangeCache, the default time (ms) that the cached range is valid and the memory budget (bytes) of the cached ranges
+ * #define GSHEET_RANGE_CACHE_TTL_MS 30000
+ * #define GSHEET_RANGE_CACHE_BUDGET 4096
+ *
+ * 🏷️ For GSheetDeltaSync, the size (rows and columns, 0 for all columns) of the hashed block and the auto sync interval (ms)
+ * #define GSHEET_DELTA_SYNC_BLOCK_ROWS 8
+ * #define GSHEET_DELTA_SYNC_BLOCK_COLS 0
+ * #define GSHEET_DELTA_SYNC_INTERVAL_MS 60000
  */
 
 #if __has_include("UserConfig.h")
@@ -17,6 +17,16 @@
 
 #define ESP_SSLCLIENT_VALID_TIMESTAMP 1690979919
 
+// The number of verified server certificate chains to remember (0 to disable)
+#if !defined(ESP_SSLCLIENT_X509_CHAIN_CACHE_SIZE)
+#define ESP_SSLCLIENT_X509_CHAIN_CACHE_SIZE 2
+#endif
+
+// The lifetime in ms of the verified certificate chain in cache
+#if !defined(ESP_SSLCLIENT_X509_CHAIN_CACHE_TTL)
+#define ESP_SSLCLIENT_X509_CHAIN_CACHE_TTL (3600 * 1000)
+#endif
+
 #ifndef SSLCLIENT_CONNECTION_UPGRADABLE
 #define SSLCLIENT_CONNECTION_UPGRADABLE
 #endif
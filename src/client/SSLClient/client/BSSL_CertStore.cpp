@@ -32,6 +32,8 @@
 #if defined(ESP_SSL_FS_SUPPORTED)
 
 #include <memory>
+#include <vector>
+#include <algorithm>
 
 #if defined(DEBUG_ESP_SSL) && defined(DEBUG_ESP_PORT)
 #define DEBUG_BSSL(fmt, ...) DEBUG_ESP_PORT.printf_P((PGM_P)PSTR("BSSL:" fmt), ##__VA_ARGS__)
@@ -54,10 +56,31 @@ namespace bssl
 
   CertStore::~CertStore()
   {
+    _closeFiles();
+    _clearCache();
     free(_indexName);
     free(_dataName);
   }
 
+  void CertStore::_closeFiles()
+  {
+    if (_index)
+      _index.close();
+    if (_data)
+      _data.close();
+    _indexCount = 0;
+  }
+
+  void CertStore::_clearCache()
+  {
+    for (size_t i = 0; i < ESP_SSLCLIENT_CERTSTORE_CACHE_SIZE; i++)
+    {
+      delete _cache[i].x509;
+      _cache[i].x509 = nullptr;
+      _cache[i].lastUsed = 0;
+    }
+  }
+
   CertStore::CertInfo CertStore::_preprocessCert(uint32_t length, uint32_t offset, const void *raw)
   {
     CertStore::CertInfo ci;
@@ -104,6 +127,10 @@ namespace bssl
 
     _fs = &fs;
 
+    // The files and decoded anchors from the previous store are no longer valid
+    _closeFiles();
+    _clearCache();
+
     // In case initCertStore called multiple times, don't leak old filenames
     free(_indexName);
     free(_dataName);
@@ -143,6 +170,9 @@ namespace bssl
     }
     offset += sizeof(magic);
 
+    // Collect the index records, they are written sorted by hash for binary search lookup
+    std::vector<CertInfo> infos;
+
     while (true)
     {
       uint8_t fileHeader[60];
@@ -174,13 +204,7 @@ namespace bssl
       // If the filename starts with "//" then this is a rename file, skip it
       if (fileHeader[0] != '/' || fileHeader[1] != '/')
       {
-        CertStore::CertInfo ci = _preprocessCert(length, offset, raw);
-        if (index.write((uint8_t *)&ci, sizeof(ci)) != (ssize_t)sizeof(ci))
-        {
-          free(raw);
-          break;
-        }
-        count++;
+        infos.push_back(_preprocessCert(length, offset, raw));
       }
 
       offset += length;
@@ -193,7 +217,26 @@ namespace bssl
       }
     }
     data.close();
+
+    std::sort(infos.begin(), infos.end(), [](const CertInfo &a, const CertInfo &b)
+              { return memcmp(a.sha256, b.sha256, sizeof(a.sha256)) < 0; });
+
+    for (size_t i = 0; i < infos.size(); i++)
+    {
+      if (index.write((uint8_t *)&infos[i], sizeof(CertInfo)) != (ssize_t)sizeof(CertInfo))
+        break;
+      count++;
+    }
     index.close();
+
+    _index = _fs->open(_indexName, FILE_READ);
+    _data = _fs->open(_dataName, FILE_READ);
+    if (!_index || !_data)
+    {
+      _closeFiles();
+      return 0;
+    }
+    _indexCount = count;
     return count;
   }
 
@@ -202,75 +245,101 @@ namespace bssl
     br_x509_minimal_set_dynamic(ctx, (void *)this, findHashedTA, freeHashedTA);
   }
 
+  bool CertStore::_findCertInfo(const void *hashed_dn, CertInfo &ci)
+  {
+    uint32_t lo = 0, hi = _indexCount;
+
+    while (lo < hi)
+    {
+      uint32_t mid = lo + (hi - lo) / 2;
+      if (!_index.seek(mid * sizeof(ci), SeekSet) || _index.read((uint8_t *)&ci, sizeof(ci)) != sizeof(ci))
+        return false;
+
+      int cmp = memcmp(ci.sha256, hashed_dn, sizeof(ci.sha256));
+      if (cmp == 0)
+        return true;
+      if (cmp < 0)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return false;
+  }
+
+  X509List *CertStore::_loadCert(const CertInfo &ci)
+  {
+    uint8_t *der = (uint8_t *)malloc(ci.length);
+    if (!der)
+    {
+      return nullptr;
+    }
+    if (!_data.seek(ci.offset, SeekSet) || (int)_data.read(der, ci.length) != (int)ci.length)
+    {
+      free(der);
+      return nullptr;
+    }
+    X509List *x509 = new (std::nothrow) X509List(der, ci.length);
+    free(der);
+    if (!x509)
+    {
+      DEBUG_BSSL("CertStore::findHashedTA: OOM\n");
+      return nullptr;
+    }
+
+    br_x509_trust_anchor *ta = (br_x509_trust_anchor *)x509->getTrustAnchors();
+    memcpy(ta->dn.data, ci.sha256, sizeof(ci.sha256));
+    ta->dn.len = sizeof(ci.sha256);
+    return x509;
+  }
+
   const br_x509_trust_anchor *CertStore::findHashedTA(void *ctx, void *hashed_dn, size_t len)
   {
     CertStore *cs = static_cast<CertStore *>(ctx);
     CertStore::CertInfo ci;
 
-    if (!cs || len != sizeof(ci.sha256) || !cs->_indexName || !cs->_dataName || !cs->_fs)
+    if (!cs || len != sizeof(ci.sha256) || !cs->_index || !cs->_data)
     {
       return nullptr;
     }
 
-    File index = cs->_fs->open(cs->_indexName, FILE_READ);
-    if (!index)
+    // Look up the decoded trust anchors first, otherwise replace the least recently used one
+    CachedTA *slot = &cs->_cache[0];
+    for (size_t i = 0; i < ESP_SSLCLIENT_CERTSTORE_CACHE_SIZE; i++)
+    {
+      CachedTA *c = &cs->_cache[i];
+      if (c->x509 && !memcmp(c->sha256, hashed_dn, sizeof(c->sha256)))
+      {
+        c->lastUsed = ++cs->_useCount;
+        return c->x509->getTrustAnchors();
+      }
+      if (slot->x509 && (!c->x509 || c->lastUsed < slot->lastUsed))
+        slot = c;
+    }
+
+    if (!cs->_findCertInfo(hashed_dn, ci))
     {
       return nullptr;
     }
 
-    while (index.read((uint8_t *)&ci, sizeof(ci)) == sizeof(ci))
+    X509List *x509 = cs->_loadCert(ci);
+    if (!x509)
     {
-      if (!memcmp(ci.sha256, hashed_dn, sizeof(ci.sha256)))
-      {
-        index.close();
-        uint8_t *der = (uint8_t *)malloc(ci.length);
-        if (!der)
-        {
-          return nullptr;
-        }
-        File data = cs->_fs->open(cs->_dataName, FILE_READ);
-        if (!data)
-        {
-          free(der);
-          return nullptr;
-        }
-        if (!data.seek(ci.offset, SeekSet))
-        {
-          data.close();
-          free(der);
-          return nullptr;
-        }
-        if ((int)data.read(der, ci.length) != (int)ci.length)
-        {
-          free(der);
-          return nullptr;
-        }
-        data.close();
-        cs->_x509 = new (std::nothrow) X509List(der, ci.length);
-        free(der);
-        if (!cs->_x509)
-        {
-          DEBUG_BSSL("CertStore::findHashedTA: OOM\n");
-          return nullptr;
-        }
-
-        br_x509_trust_anchor *ta = (br_x509_trust_anchor *)cs->_x509->getTrustAnchors();
-        memcpy(ta->dn.data, ci.sha256, sizeof(ci.sha256));
-        ta->dn.len = sizeof(ci.sha256);
-
-        return ta;
-      }
+      return nullptr;
     }
-    index.close();
-    return nullptr;
+
+    delete slot->x509;
+    slot->x509 = x509;
+    memcpy(slot->sha256, ci.sha256, sizeof(ci.sha256));
+    slot->lastUsed = ++cs->_useCount;
+
+    return x509->getTrustAnchors();
   }
 
   void CertStore::freeHashedTA(void *ctx, const br_x509_trust_anchor *ta)
   {
-    CertStore *cs = static_cast<CertStore *>(ctx);
-    (void)ta; // Unused
-    delete cs->_x509;
-    cs->_x509 = nullptr;
+    // The decoded trust anchor is kept in cache and freed when it was evicted or the store was destroyed
+    (void)ctx;
+    (void)ta;
   }
 
 }
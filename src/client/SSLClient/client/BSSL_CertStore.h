@@ -41,6 +41,11 @@
 #include "../bssl/bearssl.h"
 #include "BSSL_Helper.h"
 
+// The number of decoded trust anchors that are kept across handshakes
+#if !defined(ESP_SSLCLIENT_CERTSTORE_CACHE_SIZE)
+#define ESP_SSLCLIENT_CERTSTORE_CACHE_SIZE 2
+#endif
+
 using namespace bssl;
 
 // Base class for the certificate stores, which allow use
@@ -75,7 +80,22 @@ namespace bssl
     FS *_fs = nullptr;
     char *_indexName = nullptr;
     char *_dataName = nullptr;
-    X509List *_x509 = nullptr;
+
+    // The index (sorted by hash) and data files are kept open between the lookups
+    File _index;
+    File _data;
+    uint32_t _indexCount = 0;
+
+    // The recently used decoded trust anchors
+    class CachedTA
+    {
+    public:
+      uint8_t sha256[32];
+      X509List *x509 = nullptr;
+      uint32_t lastUsed = 0;
+    };
+    CachedTA _cache[ESP_SSLCLIENT_CERTSTORE_CACHE_SIZE];
+    uint32_t _useCount = 0;
 
     // These need to be static as they are callbacks from BearSSL C code
     static const br_x509_trust_anchor *findHashedTA(void *ctx, void *hashed_dn, size_t len);
@@ -90,6 +110,11 @@ namespace bssl
       uint32_t length;
     };
     static CertInfo _preprocessCert(uint32_t length, uint32_t offset, const void *raw);
+
+    bool _findCertInfo(const void *hashed_dn, CertInfo &ci);
+    X509List *_loadCert(const CertInfo &ci);
+    void _closeFiles();
+    void _clearCache();
   };
 
 };
@@ -293,11 +293,57 @@ namespace bssl
             br_x509_minimal_set_hash(x509, br_sha512_ID, &br_sha512_vtable);
         }
 
+        // Returns true when AES-GCM runs on the AES-NI and PCLMUL opcodes of this CPU.
+        // The bulk cipher implementations themselves are selected by the engine defaults with CPUID at run time.
+        static bool br_ssl_aes_gcm_hw_supported()
+        {
+#if defined(USE_LIB_SSL_ENGINE) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+            return br_aes_x86ni_ctr_get_vtable() != NULL && br_ghash_pclmul_get() != 0;
+#else
+            return false;
+#endif
+        }
+
+        static bool br_ssl_suite_is_ecdhe_aes_gcm(uint16_t suite)
+        {
+            return suite == BR_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256 || suite == BR_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256 ||
+                   suite == BR_TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384 || suite == BR_TLS_ECDHE_RSA_WITH_AES_256_GCM_SHA384;
+        }
+
+        static bool br_ssl_suite_is_chapol(uint16_t suite)
+        {
+            return suite == BR_TLS_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256 || suite == BR_TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256;
+        }
+
+        // Move the ChaCha20-Poly1305 suites behind the last ECDHE AES-GCM suite, the order of other suites is kept.
+        static void br_ssl_prefer_aes_gcm(uint16_t *suites, int cipher_cnt)
+        {
+            int last = -1;
+            for (int i = 0; i < cipher_cnt; i++)
+            {
+                if (br_ssl_suite_is_ecdhe_aes_gcm(suites[i]))
+                    last = i;
+            }
+
+            for (int i = last; i >= 0; i--)
+            {
+                if (br_ssl_suite_is_chapol(suites[i]))
+                {
+                    uint16_t suite = suites[i];
+                    memmove(&suites[i], &suites[i + 1], (last - i) * sizeof(suites[0]));
+                    suites[last--] = suite;
+                }
+            }
+        }
+
         // Default initializion for our SSL clients
-        static void br_ssl_client_base_init(br_ssl_client_context *cc, const uint16_t *cipher_list, int cipher_cnt)
+        // When hw_order is set, AES-GCM is preferred over ChaCha20-Poly1305 if the CPU has AES-NI.
+        static void br_ssl_client_base_init(br_ssl_client_context *cc, const uint16_t *cipher_list, int cipher_cnt, bool hw_order = false)
         {
             uint16_t suites[cipher_cnt];
             memcpy_P(suites, cipher_list, cipher_cnt * sizeof(cipher_list[0]));
+            if (hw_order && br_ssl_aes_gcm_hw_supported())
+                br_ssl_prefer_aes_gcm(suites, cipher_cnt);
             br_ssl_client_zero(cc);
             br_ssl_engine_add_flags(&cc->eng, BR_OPT_NO_RENEGOTIATION); // forbid SSL renegotiation, as we free the Private Key after handshake
             br_ssl_engine_set_versions(&cc->eng, BR_TLS10, BR_TLS12);
@@ -439,6 +485,162 @@ namespace bssl
             }
             return &xc->ctx.pkey;
         }
+
+        // The verified chain cache entry, keyed by the hash of server name and leaf certificate
+        // that was successfully validated by the x509 minimal validator.
+        struct br_x509_chain_cache_entry
+        {
+            uint8_t hash[32];
+            unsigned long validated_ms;
+            unsigned usages;
+            bool used;
+        };
+
+        // The x509 validator that wraps the x509 minimal validator.
+        // When the server name and leaf certificate match the recently verified chain,
+        // the rest of the chain is ignored and no signature verification is done.
+        struct br_x509_cached_context
+        {
+            const br_x509_class *vtable;
+            const br_x509_class **inner;
+            br_x509_chain_cache_entry *cache;
+            size_t cache_size;
+            unsigned long ttl_ms;
+            uint32_t days, seconds;
+            uint32_t cert_num;
+            br_x509_chain_cache_entry *hit;
+            br_sha256_context sha256_leaf;
+            br_x509_decoder_context leaf;
+        };
+
+        static void cached_start_chain(const br_x509_class **ctx, const char *server_name)
+        {
+            br_x509_cached_context *xc = (br_x509_cached_context *)ctx;
+#if defined(USE_EMBED_SSL_ENGINE)
+            br_x509_decoder_init(&xc->leaf, nullptr, nullptr, nullptr, nullptr);
+#elif defined(ESP32) || defined(USE_LIB_SSL_ENGINE)
+            br_x509_decoder_init(&xc->leaf, nullptr, nullptr);
+#endif
+            xc->cert_num = 0;
+            xc->hit = nullptr;
+            br_sha256_init(&xc->sha256_leaf);
+            if (server_name)
+                br_sha256_update(&xc->sha256_leaf, server_name, strlen(server_name) + 1);
+            (*xc->inner)->start_chain(xc->inner, server_name);
+        }
+
+        static void cached_start_cert(const br_x509_class **ctx, uint32_t length)
+        {
+            br_x509_cached_context *xc = (br_x509_cached_context *)ctx;
+            if (!xc->hit)
+                (*xc->inner)->start_cert(xc->inner, length);
+        }
+
+        static void cached_append(const br_x509_class **ctx, const unsigned char *buf, size_t len)
+        {
+            br_x509_cached_context *xc = (br_x509_cached_context *)ctx;
+            if (xc->hit)
+                return;
+            if (xc->cert_num == 0)
+            {
+                br_sha256_update(&xc->sha256_leaf, buf, len);
+                br_x509_decoder_push(&xc->leaf, buf, len);
+            }
+            (*xc->inner)->append(xc->inner, buf, len);
+        }
+
+        static bool cached_leaf_time_valid(const br_x509_cached_context *xc)
+        {
+            if (xc->days == 0 && xc->seconds == 0)
+                return true; // No x509 time was set, only the cache TTL is applied.
+            // The decoder of both the embedded and library engines keeps the validity period of leaf.
+            if (xc->days < xc->leaf.notbefore_days || (xc->days == xc->leaf.notbefore_days && xc->seconds < xc->leaf.notbefore_seconds))
+                return false;
+            if (xc->days > xc->leaf.notafter_days || (xc->days == xc->leaf.notafter_days && xc->seconds > xc->leaf.notafter_seconds))
+                return false;
+            return true;
+        }
+
+        static void cached_end_cert(const br_x509_class **ctx)
+        {
+            br_x509_cached_context *xc = (br_x509_cached_context *)ctx;
+            if (xc->hit)
+                return;
+
+            (*xc->inner)->end_cert(xc->inner);
+
+            if (xc->cert_num++ > 0 || br_x509_decoder_last_error(&xc->leaf) != 0 || !cached_leaf_time_valid(xc))
+                return;
+
+            uint8_t hash[32];
+            br_sha256_out(&xc->sha256_leaf, hash);
+            for (size_t i = 0; i < xc->cache_size; i++)
+            {
+                br_x509_chain_cache_entry *e = &xc->cache[i];
+                if (e->used && millis() - e->validated_ms < xc->ttl_ms && memcmp(e->hash, hash, sizeof(hash)) == 0)
+                {
+                    xc->hit = e;
+                    return;
+                }
+            }
+        }
+
+        static unsigned cached_end_chain(const br_x509_class **ctx)
+        {
+            br_x509_cached_context *xc = (br_x509_cached_context *)ctx;
+            if (xc->hit)
+                return 0;
+
+            unsigned err = (*xc->inner)->end_chain(xc->inner);
+            if (err != 0 || xc->cert_num == 0 || xc->cache_size == 0)
+                return err;
+
+            // Store the verified chain, replace the free or the oldest entry.
+            br_x509_chain_cache_entry *e = &xc->cache[0];
+            for (size_t i = 1; i < xc->cache_size && e->used; i++)
+            {
+                if (!xc->cache[i].used || xc->cache[i].validated_ms - e->validated_ms > 0x7fffffffUL)
+                    e = &xc->cache[i];
+            }
+            br_sha256_out(&xc->sha256_leaf, e->hash);
+            (*xc->inner)->get_pkey(xc->inner, &e->usages);
+            e->validated_ms = millis();
+            e->used = true;
+            return 0;
+        }
+
+        static const br_x509_pkey *cached_get_pkey(const br_x509_class *const *ctx, unsigned *usages)
+        {
+            const br_x509_cached_context *xc = (const br_x509_cached_context *)ctx;
+            if (xc->hit)
+            {
+                if (usages != nullptr)
+                    *usages = xc->hit->usages;
+                return &xc->leaf.pkey;
+            }
+            return (*xc->inner)->get_pkey(xc->inner, usages);
+        }
+
+        static void br_x509_cached_init(br_x509_cached_context *ctx, const br_x509_class **inner, br_x509_chain_cache_entry *cache, size_t cache_size, unsigned long ttl_ms, uint32_t days, uint32_t seconds)
+        {
+            static const br_x509_class br_x509_cached_vtable PROGMEM = {
+                sizeof(br_x509_cached_context),
+                cached_start_chain,
+                cached_start_cert,
+                cached_append,
+                cached_end_cert,
+                cached_end_chain,
+                cached_get_pkey};
+
+            memset(ctx, 0, sizeof *ctx);
+            ctx->vtable = &br_x509_cached_vtable;
+            ctx->inner = inner;
+            ctx->cache = cache;
+            ctx->cache_size = cache_size;
+            ctx->ttl_ms = ttl_ms;
+            ctx->days = days;
+            ctx->seconds = seconds;
+        }
     }
 
 };
@@ -505,20 +505,11 @@ void BSSL_SSL_Client::flush()
         return;
     }
 
-    if (_write_idx > 0)
-    {
-        if (mRunUntil(BR_SSL_RECVAPP) < 0)
-        {
-#if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
-            esp_ssl_debug_print(PSTR("Could not flush write buffer!"), _debug_level, esp_ssl_debug_error, __func__);
-            int error = br_ssl_engine_last_error(_eng);
-            if (error != BR_ERR_OK)
-                mPrintSSLError(error, esp_ssl_debug_error, __func__);
-            if (getWriteError())
-                mPrintClientError(getWriteError(), esp_ssl_debug_error, __func__);
-#endif
-        }
-    }
+    if (!_secure || !_eng)
+        return;
+
+    // send the partly filled record now instead of waiting for the server response
+    mFlushWrite(__func__);
 }
 
 void BSSL_SSL_Client::setBufferSizes(int recv, int xmit)
@@ -648,6 +639,15 @@ void BSSL_SSL_Client::setTrustAnchors(const X509List *ta)
     _ta = ta;
 }
 
+// Install the prebuilt trust anchors e.g. the table generated by tools/gen_trust_anchors.py
+// The array should be static as it is used directly by the x509 validator.
+void BSSL_SSL_Client::setTrustAnchors(const br_x509_trust_anchor *ta, size_t count)
+{
+    mClearAuthenticationSettings();
+    _static_ta = ta;
+    _static_ta_count = ta ? count : 0;
+}
+
 // In cases when NTP is not used, app must set a time manually to check cert validity
 void BSSL_SSL_Client::setX509Time(time_t now)
 {
@@ -1453,7 +1453,7 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
 #else
 #define CRTSTORECOND
 #endif
-    if (!_use_insecure && !_use_fingerprint && !_use_self_signed && !_knownkey CRTSTORECOND && !_ta)
+    if (!_use_insecure && !_use_fingerprint && !_use_self_signed && !_knownkey CRTSTORECOND && !_ta && !_static_ta)
     {
         esp_ssl_debug_print(PSTR("Connection *will* fail, no authentication method is setup."), _debug_level, esp_ssl_debug_warn, __func__);
     }
@@ -1475,9 +1475,9 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
         return 0;
     }
 
-    // If no cipher list yet set, use defaults
+    // If no cipher list yet set, use defaults ordered for the CPU features
     if (!_cipher_list)
-        bssl::br_ssl_client_base_init(_sc.get(), suites_P, sizeof(suites_P) / sizeof(suites_P[0]));
+        bssl::br_ssl_client_base_init(_sc.get(), suites_P, sizeof(suites_P) / sizeof(suites_P[0]), true);
     else
         bssl::br_ssl_client_base_init(_sc.get(), _cipher_list, _cipher_cnt);
 
@@ -1583,6 +1583,9 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
     _x509_minimal = nullptr;
     _x509_insecure = nullptr;
     _x509_knownkey = nullptr;
+#if ESP_SSLCLIENT_X509_CHAIN_CACHE_SIZE > 0
+    _x509_cached = nullptr;
+#endif
 
     return 1;
 }
@@ -1714,6 +1717,38 @@ int BSSL_SSL_Client::mRunUntil(const unsigned target, unsigned long timeout)
     }
 }
 
+int BSSL_SSL_Client::mFlushWrite(const char *func_name)
+{
+    if (!mSoftConnected(func_name))
+        return -1;
+
+    // hand the data copied by write() over to the engine
+    unsigned state = mUpdateEngine();
+
+    if (state & BR_SSL_SENDAPP)
+    {
+        // close the current record and send it
+        br_ssl_engine_flush(_eng, 0);
+        state = mUpdateEngine();
+    }
+
+    if (state == 0 || state == BR_SSL_CLOSED || getWriteError() != esp_ssl_ok)
+    {
+#if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
+        esp_ssl_debug_print(PSTR("Could not flush write buffer!"), _debug_level, esp_ssl_debug_error, func_name);
+        // the engine was already released when the connection was stopped
+        int error = _sc ? br_ssl_engine_last_error(_eng) : BR_ERR_OK;
+        if (error != BR_ERR_OK)
+            mPrintSSLError(error, esp_ssl_debug_error, func_name);
+        if (getWriteError())
+            mPrintClientError(getWriteError(), esp_ssl_debug_error, func_name);
+#endif
+        return -1;
+    }
+
+    return 0;
+}
+
 unsigned BSSL_SSL_Client::mUpdateEngine()
 {
     for (;;)
@@ -1973,11 +2008,17 @@ void BSSL_SSL_Client::mClearAuthenticationSettings()
     _use_self_signed = false;
     _knownkey = nullptr;
     _ta = nullptr;
+    _static_ta = nullptr;
+    _static_ta_count = 0;
     if (_esp32_ta)
     {
         delete _esp32_ta;
         _esp32_ta = nullptr;
     }
+#if ESP_SSLCLIENT_X509_CHAIN_CACHE_SIZE > 0
+    // The verified chains are only valid for the trust anchors they were verified against
+    memset(_chain_cache, 0, sizeof(_chain_cache));
+#endif
 }
 
 void BSSL_SSL_Client::mClear()
@@ -1988,11 +2029,16 @@ void BSSL_SSL_Client::mClear()
     _x509_minimal = nullptr;
     _x509_insecure = nullptr;
     _x509_knownkey = nullptr;
+#if ESP_SSLCLIENT_X509_CHAIN_CACHE_SIZE > 0
+    _x509_cached = nullptr;
+#endif
 
     freeImpl(&_iobuf_in);
     freeImpl(&_iobuf_out);
     _now = 0; // You can override or ensure time() is correct w/configTime
     _ta = nullptr;
+    _static_ta = nullptr;
+    _static_ta_count = 0;
     setBufferSizes(16384, 512); // Minimum safe
     _secure = false;
     _recvapp_buf = nullptr;
@@ -2072,6 +2118,10 @@ bool BSSL_SSL_Client::mInstallClientX509Validator()
         {
             br_x509_minimal_init(_x509_minimal.get(), &br_sha256_vtable, _esp32_ta->getTrustAnchors(), _esp32_ta->getCount());
         }
+        else if (_static_ta)
+        {
+            br_x509_minimal_init(_x509_minimal.get(), &br_sha256_vtable, _static_ta, _static_ta_count);
+        }
         else
         {
             br_x509_minimal_init(_x509_minimal.get(), &br_sha256_vtable, _ta ? _ta->getTrustAnchors() : nullptr, _ta ? _ta->getCount() : 0);
@@ -2097,6 +2147,18 @@ bool BSSL_SSL_Client::mInstallClientX509Validator()
             _certStore->installCertStore(_x509_minimal.get());
         }
 #endif
+
+#if ESP_SSLCLIENT_X509_CHAIN_CACHE_SIZE > 0
+        // Wrap the minimal validator to skip the chain validation of recently verified server
+        _x509_cached = std::make_shared<struct bssl::br_x509_cached_context>();
+        if (_x509_cached)
+        {
+            bssl::br_x509_cached_init(_x509_cached.get(), &_x509_minimal->vtable, _chain_cache, ESP_SSLCLIENT_X509_CHAIN_CACHE_SIZE, ESP_SSLCLIENT_X509_CHAIN_CACHE_TTL,
+                                      _now ? ((uint32_t)_now) / 86400 + 719528 : 0, _now ? ((uint32_t)_now) % 86400 : 0);
+            br_ssl_engine_set_x509(_eng, &_x509_cached->vtable);
+            return true;
+        }
+#endif
         br_ssl_engine_set_x509(_eng, &_x509_minimal->vtable);
     }
     return true;
@@ -2109,6 +2171,9 @@ void BSSL_SSL_Client::mFreeSSL()
     _x509_minimal = nullptr;
     _x509_insecure = nullptr;
     _x509_knownkey = nullptr;
+#if ESP_SSLCLIENT_X509_CHAIN_CACHE_SIZE > 0
+    _x509_cached = nullptr;
+#endif
     freeImpl(&_iobuf_in);
     freeImpl(&_iobuf_out);
     // Reset non-allocated ptrs (pointing to bits potentially free'd above)
@@ -154,6 +154,8 @@ public:
 
     void setTrustAnchors(const X509List *ta);
 
+    void setTrustAnchors(const br_x509_trust_anchor *ta, size_t count);
+
     void setX509Time(time_t now);
 
     void setClientRSACert(const X509List *chain, const PrivateKey *sk);
@@ -242,6 +244,9 @@ private:
 
     int mRunUntil(const unsigned target, unsigned long timeout = 0);
 
+    // Close the pending application data record and push it to the basic client without waiting for the server.
+    int mFlushWrite(const char *func_name);
+
     unsigned mUpdateEngine();
 
     void mPrintClientError(const int ssl_error, int level, const char *func_name);
@@ -292,6 +297,10 @@ private:
     std::shared_ptr<br_x509_minimal_context> _x509_minimal;
     std::shared_ptr<struct bssl::br_x509_insecure_context> _x509_insecure;
     std::shared_ptr<br_x509_knownkey_context> _x509_knownkey;
+#if ESP_SSLCLIENT_X509_CHAIN_CACHE_SIZE > 0
+    std::shared_ptr<struct bssl::br_x509_cached_context> _x509_cached;
+    bssl::br_x509_chain_cache_entry _chain_cache[ESP_SSLCLIENT_X509_CHAIN_CACHE_SIZE] = {};
+#endif
 
     unsigned char *_iobuf_in = nullptr;
     unsigned char *_iobuf_out = nullptr;
@@ -300,6 +309,10 @@ private:
 
     time_t _now = 0;
     const X509List *_ta = nullptr;
+
+    // Prebuilt (static) trust anchors, used in place without parsing or copying
+    const br_x509_trust_anchor *_static_ta = nullptr;
+    size_t _static_ta_count = 0;
 #if defined(ESP_SSL_FS_SUPPORTED)
     CertStoreBase *_certStore = 0;
 #endif
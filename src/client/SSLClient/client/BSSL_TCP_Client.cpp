@@ -323,6 +323,11 @@ void BSSL_TCP_Client::setTrustAnchors(const X509List *ta)
     _ssl_client.setTrustAnchors(ta);
 }
 
+void BSSL_TCP_Client::setTrustAnchors(const br_x509_trust_anchor *ta, size_t count)
+{
+    _ssl_client.setTrustAnchors(ta, count);
+}
+
 void BSSL_TCP_Client::setX509Time(time_t now)
 {
     _ssl_client.setX509Time(now);
@@ -351,6 +351,15 @@ public:
 
     void setTrustAnchors(const X509List *ta);
 
+    /**
+     * Set the prebuilt trust anchors.
+     * @param ta The static array of trust anchors e.g. generated by tools/gen_trust_anchors.py.
+     * @param count The number of trust anchors in array.
+     *
+     * The trust anchors are used in place, no PEM/DER parsing and no memory allocation are required.
+     */
+    void setTrustAnchors(const br_x509_trust_anchor *ta, size_t count);
+
     void setX509Time(time_t now);
 
     void setClientRSACert(const X509List *cert, const PrivateKey *sk);
@@ -74,6 +74,16 @@ protected:
 
     size_t slotCountBase(GSheetAsyncClientClass *aClient) { return aClient->sVec.size(); }
 
+    int slotIndexBase(GSheetAsyncClientClass *aClient, gsheet_async_data_item_t *sData)
+    {
+        for (size_t i = 0; sData && i < aClient->sVec.size(); i++)
+        {
+            if (aClient->sVec[i] == sData->addr)
+                return i;
+        }
+        return -1;
+    }
+
     void setLastErrorBase(GSheetAsyncResult *aResult, int code, const String &message)
     {
         if (aResult)
@@ -0,0 +1,243 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2026 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef GSHEET_CORE_ARENA_H
+#define GSHEET_CORE_ARENA_H
+
+#include <Arduino.h>
+#include "./core/Memory.h"
+
+// The default block size of arena, the larger allocation gets its own block.
+#if !defined(GSHEET_ARENA_BLOCK_SIZE)
+#define GSHEET_ARENA_BLOCK_SIZE 512
+#endif
+
+// The arena position that the later allocations can be rolled back to.
+struct gsheet_arena_mark_t
+{
+    void *block = nullptr;
+    size_t used = 0;
+};
+
+/**
+ * The bump allocator for the short-lived buffers, the allocations are released all at once
+ * by reset() or rolled back to the position by rewind().
+ */
+class GSheetArena
+{
+private:
+    struct block_t
+    {
+        block_t *next;
+        size_t size;
+        size_t used;
+    };
+
+    block_t *head = nullptr;
+    GSheetMemory mem;
+
+    static size_t align(size_t len) { return (len + 3) & ~(size_t)3; }
+
+    uint8_t *data(block_t *b) { return reinterpret_cast<uint8_t *>(b) + align(sizeof(block_t)); }
+
+    void pop()
+    {
+        block_t *b = head;
+        head = head->next;
+        mem.release(&b);
+    }
+
+public:
+    GSheetArena() {}
+    ~GSheetArena() { release(); }
+
+    /**
+     * Allocate the 4 bytes aligned memory from arena.
+     *
+     * @param len The length of memory to allocate.
+     * @param clear The option to clear the memory.
+     * @return The pointer to the memory or null if out of memory.
+     */
+    void *alloc(size_t len, bool clear = true)
+    {
+        len = align(len ? len : 1);
+        if (!head || head->size - head->used < len)
+        {
+            size_t size = len > GSHEET_ARENA_BLOCK_SIZE ? len : GSHEET_ARENA_BLOCK_SIZE;
+            block_t *b = reinterpret_cast<block_t *>(mem.alloc(align(sizeof(block_t)) + size, false));
+            if (!b)
+                return nullptr;
+            b->next = head;
+            b->size = size;
+            b->used = 0;
+            head = b;
+        }
+        void *p = data(head) + head->used;
+        head->used += len;
+        if (clear)
+            memset(p, 0, len);
+        return p;
+    }
+
+    // Copy the string to arena.
+    char *strdup(const String &str)
+    {
+        char *p = reinterpret_cast<char *>(alloc(str.length() + 1, false));
+        if (p)
+            memcpy(p, str.c_str(), str.length() + 1);
+        return p;
+    }
+
+    // Get the current position.
+    gsheet_arena_mark_t mark() const
+    {
+        gsheet_arena_mark_t m;
+        m.block = head;
+        m.used = head ? head->used : 0;
+        return m;
+    }
+
+    // Roll back the allocations made after the position, the first block is kept for reuse.
+    void rewind(const gsheet_arena_mark_t &m)
+    {
+        while (head && head != m.block && (m.block || head->next))
+            pop();
+        if (head)
+            head->used = head == m.block ? m.used : 0;
+    }
+
+    // Release all allocations and keep the first block for reuse.
+    void reset()
+    {
+        gsheet_arena_mark_t m;
+        rewind(m);
+    }
+
+    // Release all allocations and blocks.
+    void release()
+    {
+        while (head)
+            pop();
+    }
+
+    // Get the total bytes of blocks.
+    size_t capacity() const
+    {
+        size_t n = 0;
+        for (block_t *b = head; b; b = b->next)
+            n += b->size;
+        return n;
+    }
+};
+
+// The shared arena for the scratch buffers of the request builders, it is used by one caller at a time.
+struct gsheet_scratch_arena_t
+{
+    GSheetArena arena;
+    bool busy = false;
+#if defined(ESP32)
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+#elif defined(GSHEET_MEMORY_USE_STD_MUTEX)
+    std::mutex mux;
+#endif
+
+    // Only the busy flag is guarded, the arena is used outside the lock by its owner.
+    bool acquire()
+    {
+#if defined(ESP32)
+        portENTER_CRITICAL(&mux);
+#elif defined(GSHEET_MEMORY_USE_STD_MUTEX)
+        mux.lock();
+#endif
+        bool ret = !busy;
+        busy = true;
+#if defined(ESP32)
+        portEXIT_CRITICAL(&mux);
+#elif defined(GSHEET_MEMORY_USE_STD_MUTEX)
+        mux.unlock();
+#endif
+        return ret;
+    }
+
+    void release()
+    {
+#if defined(ESP32)
+        portENTER_CRITICAL(&mux);
+#elif defined(GSHEET_MEMORY_USE_STD_MUTEX)
+        mux.lock();
+#endif
+        busy = false;
+#if defined(ESP32)
+        portEXIT_CRITICAL(&mux);
+#elif defined(GSHEET_MEMORY_USE_STD_MUTEX)
+        mux.unlock();
+#endif
+    }
+};
+
+// The single scratch arena of the program.
+inline gsheet_scratch_arena_t &gsheet_scratch_arena()
+{
+    static gsheet_scratch_arena_t scratch;
+    return scratch;
+}
+
+/**
+ * The scope of scratch allocations, the allocations are rolled back when it goes out of scope.
+ *
+ * The shared scratch arena is used when it is free, the caller in the other task while it is used
+ * or the nested scope gets the local arena instead.
+ */
+class GSheetScratchArena
+{
+private:
+    GSheetArena local;
+    GSheetArena *arena = nullptr;
+    gsheet_arena_mark_t m;
+    bool shared = false;
+
+public:
+    GSheetScratchArena()
+    {
+        shared = gsheet_scratch_arena().acquire();
+        arena = shared ? &gsheet_scratch_arena().arena : &local;
+        m = arena->mark();
+    }
+
+    ~GSheetScratchArena()
+    {
+        arena->rewind(m);
+        if (shared)
+            gsheet_scratch_arena().release();
+    }
+
+    GSheetScratchArena(const GSheetScratchArena &) = delete;
+    GSheetScratchArena &operator=(const GSheetScratchArena &) = delete;
+
+    void *alloc(size_t len, bool clear = true) { return arena->alloc(len, clear); }
+
+    char *strdup(const String &str) { return arena->strdup(str); }
+};
+
+#endif
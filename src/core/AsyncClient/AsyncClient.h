@@ -31,6 +31,7 @@
 #include "./core/AsyncClient/ResponseHandler.h"
 #include "./core/NetConfig.h"
 #include "./core/Memory.h"
+#include "./core/Arena.h"
 #include "./core/FileConfig.h"
 #include "./core/Base64.h"
 #include "./core/Error.h"
@@ -93,6 +94,8 @@ public:
     uint32_t ref_result_addr = 0;
     GSheetAsyncResultCallback cb = NULL;
     GSheetTimer err_timer;
+    // The per-request memory, released when the slot is reset or removed.
+    GSheetArena arena;
     gsheet_async_data_item_t()
     {
         addr = reinterpret_cast<uint32_t>(this);
@@ -127,6 +130,7 @@ public:
         cancel = false;
         cb = NULL;
         err_timer.reset();
+        arena.reset();
     }
 };
 
@@ -135,6 +139,8 @@ struct gsheet_slot_options_t
 public:
     bool auth_used = false;
     bool async = false;
+    // The auth request is queued behind the pending requests instead of taking the first slot e.g. the background token refresh.
+    bool queued = false;
     gsheet_app_token_t *app_token = nullptr;
     gsheet_slot_options_t() {}
     gsheet_slot_options_t(bool auth_used, bool async)
@@ -235,6 +241,20 @@ private:
         return ret;
     }
 
+    // The link status check for the I/O, the reconnection is done by the scheduler (process).
+    gsheet_function_return_type networkLinkUp(gsheet_async_data_item_t *sData)
+    {
+        if (!sData)
+            return gsheet_function_return_type_failure;
+
+        if (!netLinkUp(sData))
+        {
+            setAsyncError(sData, sData->state, GSHEET_ERROR_TCP_DISCONNECTED, true, false);
+            return gsheet_function_return_type_failure;
+        }
+        return gsheet_function_return_type_complete;
+    }
+
     gsheet_function_return_type sendHeader(gsheet_async_data_item_t *sData, const char *data)
     {
         return send(sData, (uint8_t *)data, data ? strlen(data) : 0, data ? strlen(data) : 0, gsheet_async_state_send_header);
@@ -276,7 +296,9 @@ private:
             }
         }
 
-        uint8_t *buf = nullptr;
+        // The chunk buffer is taken from the slot arena and rolled back after sending.
+        gsheet_arena_mark_t m = sData->arena.mark();
+        uint8_t *buf = nullptr, *encoded = nullptr;
         int toSend = 0;
         if (sData->request.file_data.filename.length() > 0 ? sData->request.file_data.file.available() : sData->request.file_data.data_pos < sData->request.file_data.data_size)
         {
@@ -296,7 +318,7 @@ private:
                         toSend = sData->request.file_data.data_size - sData->request.file_data.data_pos;
                 }
 
-                buf = reinterpret_cast<uint8_t *>(mem.alloc(toSend));
+                buf = reinterpret_cast<uint8_t *>(sData->arena.alloc(toSend, false));
                 if (sData->request.file_data.filename.length() > 0)
                 {
                     toSend = sData->request.file_data.file.read(buf, toSend);
@@ -314,17 +336,16 @@ private:
                     sData->request.file_data.data_pos += toSend;
                 }
 
-                uint8_t *temp = (uint8_t *)but.encodeToChars(mem, buf, toSend);
-                mem.release(&buf);
-                toSend = strlen((char *)temp);
-                buf = temp;
+                encoded = (uint8_t *)but.encodeToChars(mem, buf, toSend);
+                toSend = strlen((char *)encoded);
+                buf = encoded;
             }
             else
             {
 
                 toSend = totalLen - sData->request.file_data.data_pos < GSHEET_CHUNK_SIZE ? totalLen - sData->request.file_data.data_pos : GSHEET_CHUNK_SIZE;
 
-                buf = reinterpret_cast<uint8_t *>(mem.alloc(toSend));
+                buf = reinterpret_cast<uint8_t *>(sData->arena.alloc(toSend, false));
 
                 if (sData->request.file_data.filename.length() > 0)
                 {
@@ -352,8 +373,9 @@ private:
 
     exit:
 
-        if (buf)
-            mem.release(&buf);
+        if (encoded)
+            mem.release(&encoded);
+        sData->arena.rewind(m);
 #endif
 
         return ret;
@@ -421,7 +443,7 @@ private:
 
     gsheet_function_return_type send(gsheet_async_data_item_t *sData)
     {
-        gsheet_function_return_type ret = networkConnect(sData);
+        gsheet_function_return_type ret = networkLinkUp(sData);
 
         if (ret != gsheet_function_return_type_complete)
             return ret;
@@ -447,22 +469,34 @@ private:
                 sData->auth_ts = auth_ts;
             }
 
-            if (sData->request.app_token && sData->request.app_token->auth_data_type != gsheet_user_auth_data_undefined)
+            bool token = sData->request.app_token && sData->request.app_token->auth_data_type != gsheet_user_auth_data_undefined;
+            bool coalesce = payloadCoalesced(sData);
+
+            if (token && sData->request.app_token->val[gsheet_app_tk_ns::token].length() == 0)
             {
-                if (sData->request.app_token->val[gsheet_app_tk_ns::token].length() == 0)
-                {
-                    // In case missing auth token error.
-                    setAsyncError(sData, sData->state, GSHEET_ERROR_UNAUTHENTICATE, true, false);
-                    return gsheet_function_return_type_failure;
-                }
+                // In case missing auth token error.
+                setAsyncError(sData, sData->state, GSHEET_ERROR_UNAUTHENTICATE, true, false);
+                return gsheet_function_return_type_failure;
+            }
 
-                header = sData->request.val[gsheet_req_hndlr_ns::header];
+            if (!token && !coalesce)
+                return sendHeader(sData, sData->request.val[gsheet_req_hndlr_ns::header].c_str());
+
+            header = sData->request.val[gsheet_req_hndlr_ns::header];
+            if (token)
                 header.replace(GSHEET_AUTH_PLACEHOLDER, sData->request.app_token->val[gsheet_app_tk_ns::token]);
-                ret = sendHeader(sData, header.c_str());
-                header.remove(0, header.length());
-                return ret;
-            }
-            return sendHeader(sData, sData->request.val[gsheet_req_hndlr_ns::header].c_str());
+
+            // The small payload is sent together with the header to fill the TLS records and TCP segments.
+            if (coalesce)
+                header += sData->request.val[gsheet_req_hndlr_ns::payload];
+
+            ret = sendHeader(sData, header.c_str());
+            header.remove(0, header.length());
+
+            if (coalesce && ret == gsheet_function_return_type_complete)
+                sData->state = gsheet_async_state_read_response;
+
+            return ret;
         }
         else if (sData->state == gsheet_async_state_send_payload)
         {
@@ -478,10 +512,22 @@ private:
         return ret;
     }
 
+    // Returns true when the in-memory payload fits in one chunk and can be sent with the header.
+    bool payloadCoalesced(gsheet_async_data_item_t *sData)
+    {
+        if (sData->request.method == gsheet_async_request_handler_t::http_get || sData->request.method == gsheet_async_request_handler_t::http_delete)
+            return false;
+
+        if (sData->request.file_data.filename.length() || sData->request.file_data.data)
+            return false;
+
+        return sData->request.val[gsheet_req_hndlr_ns::payload].length() > 0 && sData->request.val[gsheet_req_hndlr_ns::payload].length() <= GSHEET_CHUNK_SIZE;
+    }
+
     gsheet_function_return_type receive(gsheet_async_data_item_t *sData)
     {
 
-        gsheet_function_return_type ret = networkConnect(sData);
+        gsheet_function_return_type ret = networkLinkUp(sData);
 
         if (ret != gsheet_function_return_type_complete)
             return ret;
@@ -535,6 +581,10 @@ private:
         sData->error.state = state;
         sData->error.code = code;
 
+        // The I/O error may be caused by the network disconnection, the link status should be checked again.
+        if (code == GSHEET_ERROR_TCP_SEND || code == GSHEET_ERROR_TCP_RECEIVE_TIMEOUT)
+            net.status_valid = false;
+
         if (toRemove)
             sData->to_remove = toRemove;
 
@@ -672,7 +722,7 @@ private:
 
     bool readResponse(gsheet_async_data_item_t *sData)
     {
-        if (!netConnect(sData) || !client || !sData)
+        if (!client || !sData || !netLinkUp(sData))
             return false;
 
         if (sData->response.tcpAvailable(client_type, client, async_tcp_config) > 0)
@@ -1300,68 +1350,93 @@ private:
 
     gsheet_function_return_type netConnect(gsheet_async_data_item_t *sData)
     {
-        if (!netStatus(sData))
-        {
-            bool recon = net.reconnect;
+        if (netLinkUp(sData))
+            return gsheet_function_return_type_complete;
 
-            if (net.wifi && net.net_timer.feedCount() == 0)
-                recon = true;
+        bool recon = net.reconnect;
 
-            // Self network connection controls.
-            bool self_connect = net.network_data_type == gsheet_network_data_gsm_network || net.network_data_type == gsheet_network_data_ethernet_network;
+        if (net.wifi && net.net_timer.feedCount() == 0)
+            recon = true;
 
-            if (!self_connect && net.net_timer.remaining() == 0)
-                net.net_timer.feed(GSHEET_NET_RECONNECT_TIMEOUT_SEC);
+        // Self network connection controls.
+        bool self_connect = net.network_data_type == gsheet_network_data_gsm_network || net.network_data_type == gsheet_network_data_ethernet_network;
 
-            if (recon && (self_connect || (!self_connect && net.net_timer.remaining() == 0)))
-            {
-                if (!self_connect)
-                    setDebugBase(app_debug, FPSTR("Reconnecting to network..."));
+        if (!self_connect && net.net_timer.remaining() == 0)
+            net.net_timer.feed(GSHEET_NET_RECONNECT_TIMEOUT_SEC);
 
-                if (net.network_data_type == gsheet_network_data_generic_network)
-                {
+        if (recon && (self_connect || (!self_connect && net.net_timer.remaining() == 0)))
+        {
+            if (!self_connect)
+                setDebugBase(app_debug, FPSTR("Reconnecting to network..."));
+
+            if (net.network_data_type == gsheet_network_data_generic_network)
+            {
 #if defined(GSHEET_HAS_WIFI_DISCONNECT)
-                    // We can reconnect WiFi when device connected via built-in WiFi that supports reconnect
-                    if (GSHEET_WIFI_CONNECTED)
-                    {
-                        WiFi.reconnect();
-                        return netStatus(sData) ? gsheet_function_return_type_complete : gsheet_function_return_type_failure;
-                    }
-#endif
-                    if (net.generic.net_con_cb)
-                        net.generic.net_con_cb();
-                }
-                else if (net.network_data_type == gsheet_network_data_gsm_network)
+                // We can reconnect WiFi when device connected via built-in WiFi that supports reconnect
+                if (GSHEET_WIFI_CONNECTED)
                 {
-                    if (gprsConnect(sData) == gsheet_function_return_type_continue)
-                        return gsheet_function_return_type_continue;
+                    WiFi.reconnect();
+                    return netStatus(sData) ? gsheet_function_return_type_complete : gsheet_function_return_type_failure;
                 }
-                else if (net.network_data_type == gsheet_network_data_ethernet_network)
-                {
-                    if (ethernetConnect(sData) == gsheet_function_return_type_continue)
-                        return gsheet_function_return_type_continue;
-                }
-                else if (net.network_data_type == gsheet_network_data_default_network)
-                {
+#endif
+                if (net.generic.net_con_cb)
+                    net.generic.net_con_cb();
+            }
+            else if (net.network_data_type == gsheet_network_data_gsm_network)
+            {
+                if (gprsConnect(sData) == gsheet_function_return_type_continue)
+                    return gsheet_function_return_type_continue;
+            }
+            else if (net.network_data_type == gsheet_network_data_ethernet_network)
+            {
+                if (ethernetConnect(sData) == gsheet_function_return_type_continue)
+                    return gsheet_function_return_type_continue;
+            }
+            else if (net.network_data_type == gsheet_network_data_default_network)
+            {
 
 #if defined(GSHEET_WIFI_IS_AVAILABLE)
 #if defined(ESP32) || defined(ESP8266)
-                    if (net.wifi && net.wifi->credentials.size())
-                        net.wifi->reconnect();
-                    else
-                        WiFi.reconnect();
+                if (net.wifi && net.wifi->credentials.size())
+                    net.wifi->reconnect();
+                else
+                    WiFi.reconnect();
 #else
-                    if (net.wifi && net.wifi->credentials.size())
-                        net.wifi->reconnect();
+                if (net.wifi && net.wifi->credentials.size())
+                    net.wifi->reconnect();
 #endif
 #endif
-                }
             }
         }
 
         return netStatus(sData) ? gsheet_function_return_type_complete : gsheet_function_return_type_failure;
     }
 
+#if defined(ESP32) && defined(GSHEET_WIFI_IS_AVAILABLE)
+    static void netLinkEvent(WiFiEvent_t event)
+    {
+        (void)event;
+        gsheet_net_link_events() = gsheet_net_link_events() + 1;
+    }
+#endif
+
+    // Returns the cached link status which is updated by the network events or polling interval.
+    bool netLinkUp(gsheet_async_data_item_t *sData)
+    {
+#if defined(ESP32) && defined(GSHEET_WIFI_IS_AVAILABLE)
+        // The WiFi and Ethernet events on ESP32.
+        static bool event_registered = false;
+        if (!event_registered)
+        {
+            WiFi.onEvent(netLinkEvent);
+            event_registered = true;
+        }
+#endif
+        if (!net.status_valid || net.status_events != gsheet_net_link_events() || millis() - net.status_ms >= GSHEET_NET_STATUS_POLL_INTERVAL_MS)
+            netStatus(sData);
+        return net.network_status;
+    }
+
     bool netStatus(gsheet_async_data_item_t *sData)
     {
         // We will not invoke the network status request when device has built-in WiFi or Ethernet and it is connected.
@@ -1386,13 +1461,17 @@ private:
         else
             net.network_status = false;
 
+        net.status_valid = true;
+        net.status_events = gsheet_net_link_events();
+        net.status_ms = millis();
+
         return net.network_status;
     }
 
     int sMan(gsheet_slot_options_t &options)
     {
         int slot = -1;
-        if (options.auth_used)
+        if (options.auth_used && !options.queued)
             slot = 0;
         else
         {
@@ -1673,7 +1752,8 @@ private:
         setLastError(sData);
         // data available from sync and asyn request
         returnResult(sData, true);
-        reset(sData, sData->auth_used);
+        // Only the first slot uses the connection.
+        reset(sData, sData->auth_used && slot == 0);
         if (!sData->auth_used)
             delete sData;
         sData = nullptr;
@@ -1705,7 +1785,8 @@ private:
             updateEvent(app_event);
             sData->aResult.updateData();
 
-            if (networkConnect(sData) == gsheet_function_return_type_failure)
+            gsheet_function_return_type net_ret = networkConnect(sData);
+            if (net_ret == gsheet_function_return_type_failure)
             {
                 // In case TCP (network) disconnected error.
                 setAsyncError(sData, sData->state, GSHEET_ERROR_TCP_DISCONNECTED, true, false);
@@ -1718,6 +1799,10 @@ private:
                 return exitProcess(false);
             }
 
+            // The network reconnection is in progress.
+            if (net_ret == gsheet_function_return_type_continue)
+                return exitProcess(false);
+
             if (sData->async && !async)
                 return exitProcess(false);
 
@@ -1764,7 +1849,7 @@ private:
                 }
                 else if (!sData->async) // wait for non async
                 {
-                    while (!sData->response.tcpAvailable(client_type, client, async_tcp_config) && networkConnect(sData) == gsheet_function_return_type_complete)
+                    while (!sData->response.tcpAvailable(client_type, client, async_tcp_config) && netLinkUp(sData))
                     {
                         gsheet_sys_idle();
                         if (handleReadTimeout(sData))
@@ -27,6 +27,7 @@
 #include <Arduino.h>
 #include <Client.h>
 #include "RequestHandler.h"
+#include "./core/Memory.h"
 
 #define GSHEET_TCP_READ_TIMEOUT_SEC 30
 
@@ -103,9 +104,8 @@ public:
 
     ~gsheet_async_response_handler_t()
     {
-        if (toFill)
-            free(toFill);
-        toFill = nullptr;
+        GSheetMemory mem;
+        mem.release(&toFill);
         toFillLen = 0;
         toFillIndex = 0;
     }
@@ -118,9 +118,8 @@ public:
         payloadRead = 0;
         error.resp_code = 0;
         error.string.remove(0, error.string.length());
-        if (toFill)
-            delete toFill;
-        toFill = nullptr;
+        GSheetMemory mem;
+        mem.release(&toFill);
         toFillLen = 0;
         toFillIndex = 0;
         for (size_t i = 0; i < gsheet_res_hndlr_ns::max_type; i++)
@@ -57,6 +57,7 @@ class GSheetAsyncResult : public GSheetResultBase
     friend class GSheetAsyncClientClass;
     friend class GSheetAppBase;
     friend class gsheet_async_data_item_t;
+    friend class GSheetResultFanout;
 
 private:
     uint32_t addr = 0;
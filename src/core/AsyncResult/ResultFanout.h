@@ -0,0 +1,95 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2026 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef GSHEET_RESULT_FANOUT_H
+#define GSHEET_RESULT_FANOUT_H
+
+#include <Arduino.h>
+#include "./core/Error.h"
+#include "./core/AsyncResult/AsyncResult.h"
+
+/**
+ * The receiver of the result that is passed by the coalescers and caches, the async result or callback.
+ */
+struct gsheet_result_owner_t
+{
+    GSheetAsyncResult *aResult = nullptr;
+    GSheetAsyncResultCallback cb = NULL;
+    gsheet_result_owner_t() {}
+    gsheet_result_owner_t(GSheetAsyncResult *aResult, GSheetAsyncResultCallback cb)
+    {
+        this->aResult = aResult;
+        this->cb = cb;
+    }
+};
+
+/**
+ * Pass the result of the shared request to its owners.
+ */
+class GSheetResultFanout
+{
+public:
+    GSheetResultFanout() {}
+
+    /**
+     * Take the error of the completed request.
+     * The error of result is read once, it is consumed by reading.
+     *
+     * @param result The async result of request.
+     * @param failed The result error status (isError).
+     * @param message The String to store the error message.
+     * @return int The error code, GSHEET_ERROR_OPERATION_CANCELLED for the failed request without error code or 0 if not failed.
+     */
+    int takeError(GSheetAsyncResult &result, bool failed, String &message)
+    {
+        if (!failed)
+            return 0;
+        int code = result.error().code();
+        message = result.error().message();
+        return code ? code : GSHEET_ERROR_OPERATION_CANCELLED;
+    }
+
+    /**
+     * Set the payload or error to the owner's async result and call its callback.
+     *
+     * @param owner The gsheet_result_owner_t that receives the result.
+     * @param payload The payload of the owner.
+     * @param code The error code or 0 for success.
+     * @param message The error message.
+     */
+    void deliver(const gsheet_result_owner_t &owner, const String &payload, int code, const String &message)
+    {
+        GSheetAsyncResult tmp;
+        GSheetAsyncResult &res = owner.aResult ? *owner.aResult : tmp;
+        res.clear();
+        if (code)
+            res.error().setLastError(code, message);
+        else
+            res.setPayload(payload);
+        if (owner.cb)
+            owner.cb(res);
+    }
+};
+
+#endif
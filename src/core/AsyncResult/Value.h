@@ -214,16 +214,114 @@ public:
         }
     }
 
-    template <typename T>
-    auto to(const char *payload) -> typename std::enable_if<v_number<T>::value || std::is_same<T, bool>::value, T>::type
+    /**
+     * Parse the JSON number in one pass.
+     * The numbers that have up to 19 significant digits and the exponent within 10^±22 are converted exactly
+     * without strtod, the others are converted by strtod.
+     *
+     * @param p The first character of number.
+     * @param end The end of source.
+     * @param d The parsed value.
+     * @param i The parsed value in integer (truncated if the number has fraction).
+     * @param integral Set to true when the number is integer that fits int64_t.
+     * @return const char * The position after the number or p if it is not a number.
+     */
+    const char *parseNumber(const char *p, const char *end, double &d, int64_t &i, bool &integral)
     {
-        if (!useLength && strlen(payload) > 0)
+        static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        const char *s = p;
+        bool neg = p < end && *p == '-';
+        if (neg)
+            p++;
+
+        uint64_t m = 0;
+        int digits = 0, exp10 = 0, dropped = 0;
+        const char *d0 = p;
+        for (; p < end && *p >= '0' && *p <= '9'; p++)
+        {
+            if (digits < 19)
+            {
+                m = m * 10 + (*p - '0');
+                if (m)
+                    digits++;
+            }
+            else
+            {
+                exp10++;
+                dropped++;
+            }
+        }
+
+        if (p == d0)
+            return s;
+
+        bool fraction = false;
+        if (p < end && *p == '.')
+        {
+            fraction = true;
+            for (p++; p < end && *p >= '0' && *p <= '9'; p++)
+            {
+                if (digits < 19)
+                {
+                    m = m * 10 + (*p - '0');
+                    if (m)
+                        digits++;
+                    exp10--;
+                }
+                else
+                    dropped++;
+            }
+        }
+
+        if (p < end && (*p == 'e' || *p == 'E'))
+        {
+            const char *e = p + 1;
+            bool eneg = e < end && *e == '-';
+            if (e < end && (*e == '-' || *e == '+'))
+                e++;
+            int x = 0;
+            const char *x0 = e;
+            for (; e < end && *e >= '0' && *e <= '9'; e++)
+                x = x < 10000 ? x * 10 + (*e - '0') : x;
+            if (e > x0)
+            {
+                exp10 += eneg ? -x : x;
+                fraction = true;
+                p = e;
+            }
+        }
+
+        integral = !fraction && dropped == 0 && m <= (uint64_t)INT64_MAX + (neg ? 1 : 0);
+        if (integral)
         {
-            setInt(payload);
-            setFloat(payload);
+            i = neg ? (int64_t)(0 - m) : (int64_t)m;
+            d = neg ? -(double)m : (double)m;
+            return p;
+        }
+
+        // The exact conversion when both mantissa and power of ten are exactly representable in double.
+        if (dropped == 0 && m <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22)
+        {
+            d = exp10 < 0 ? (double)m / pow10[-exp10] : (double)m * pow10[exp10];
+            if (neg)
+                d = -d;
         }
         else
-            setBool(strlen(payload));
+            d = strtod(s, nullptr);
+
+        i = d >= -9.2233720368547758e18 && d < 9.2233720368547758e18 ? (int64_t)d : 0;
+        return p;
+    }
+
+    template <typename T>
+    auto to(const char *payload) -> typename std::enable_if<v_number<T>::value || std::is_same<T, bool>::value, T>::type
+    {
+        size_t len = payload ? strlen(payload) : 0;
+        if (!useLength && len > 0)
+            setNumber(payload, len);
+        else
+            setBool(len);
 
         if (std::is_same<T, int>::value)
             return iVal.int32;
@@ -318,26 +416,25 @@ private:
         }
     }
 
-    void setInt(const char *value)
+    // Parse the integer and floating point values at once.
+    // Only the plain decimal number is parsed in one pass, the other values e.g. with leading spaces, '+', exponent,
+    // out of int64_t range or the text (true is 0) are converted by strtoll (strtoull) and strtod as before.
+    void setNumber(const char *value, size_t len)
     {
-        if (strlen(value) > 0)
+        double d = 0;
+        int64_t i = 0;
+        bool integral = false;
+        const char *end = parseNumber(value, value + len, d, i, integral);
+        if (end == value + len && (integral || (d > -9.2233720368547758e18 && d < 9.2233720368547758e18 && !memchr(value, 'e', len) && !memchr(value, 'E', len))))
         {
-            char *pEnd;
-            value[0] == '-' ? iVal.int64 = strtoll(value, &pEnd, 10) : iVal.uint64 = strtoull(value, &pEnd, 10);
+            iVal.int64 = i;
+            fVal.setd(d);
+            return;
         }
-        else
-            iVal = {0};
-    }
 
-    void setFloat(const char *value)
-    {
-        if (strlen(value) > 0)
-        {
-            char *pEnd;
-            fVal.setd(strtod(value, &pEnd));
-        }
-        else
-            fVal.setd(0);
+        char *pEnd;
+        value[0] == '-' ? iVal.int64 = strtoll(value, &pEnd, 10) : iVal.uint64 = strtoull(value, &pEnd, 10);
+        fVal.setd(strtod(value, &pEnd));
     }
 };
 
@@ -32,6 +32,16 @@
 
 #define GSHEET_DEFAULT_TOKEN_TTL 3300
 
+// The percentage of token time to live, after which the new token will be requested while the current token is still in use.
+#if !defined(GSHEET_TOKEN_REFRESH_PERCENT)
+#define GSHEET_TOKEN_REFRESH_PERCENT 80
+#endif
+
+// The seconds to wait for the token of other app that uses the same credentials, before requesting its own token.
+#if !defined(GSHEET_TOKEN_SHARE_TIMEOUT_SEC)
+#define GSHEET_TOKEN_SHARE_TIMEOUT_SEC 30
+#endif
+
 namespace gsheet_sa_ns
 {
     enum data_item_type_t
@@ -194,6 +204,11 @@ namespace gsheet
                 this->timestatus_cb = rhs.timestatus_cb;
                 this->expire = rhs.expire;
                 this->step = rhs.step;
+                this->token = rhs.token;
+                this->token_exp = rhs.token_exp;
+#if defined(GSHEET_ENABLE_FS)
+                this->token_file.copy(rhs.token_file);
+#endif
             }
 
             void clear()
@@ -203,6 +218,11 @@ namespace gsheet
                 timestatus_cb = NULL;
                 expire = GSHEET_DEFAULT_TOKEN_TTL;
                 step = gsheet_jwt_step_begin;
+                token.remove(0, token.length());
+                token_exp = 0;
+#if defined(GSHEET_ENABLE_FS)
+                token_file.clear();
+#endif
             }
 
         protected:
@@ -210,6 +230,13 @@ namespace gsheet
             gsheet_jwt_step step = gsheet_jwt_step_begin;
             GSheetTimeStatusCallback timestatus_cb = NULL;
             size_t expire = GSHEET_DEFAULT_TOKEN_TTL;
+            // The cached access token and its absolute expiry time (timestamp in seconds).
+            String token;
+            uint32_t token_exp = 0;
+#if defined(GSHEET_ENABLE_FS)
+            // The file to keep the access token across restarts.
+            gsheet_file_config_data token_file;
+#endif
         };
 #endif
 
@@ -306,7 +333,7 @@ namespace gsheet
 
 #if defined(GSHEET_ENABLE_FS)
 
-#if defined(GSHEET_ENABLE_ACCESS_TOKEN)
+#if defined(GSHEET_ENABLE_ACCESS_TOKEN) || defined(GSHEET_ENABLE_SERVICE_AUTH)
 
     class GSheetUserTokenFileParser
     {
@@ -317,7 +344,8 @@ namespace gsheet
             token_type_id_token,
             token_type_access_token,
             token_type_custom_token,
-            token_type_legacy_token
+            token_type_legacy_token,
+            token_type_sa_access_token
         };
 
         static bool parseUserFile(token_type type, FILEOBJ userfile, gsheet_user_auth_data &auth_data)
@@ -370,6 +398,18 @@ namespace gsheet
 #endif
                     return true;
                 }
+                else if (type == token_type_sa_access_token && tokenSize == 3)
+                {
+#if defined(GSHEET_ENABLE_SERVICE_AUTH)
+                    // <client email>,<access token>,<expiry timestamp>
+                    if (tokens[0] == auth_data.sa.val[gsheet_sa_ns::cm])
+                    {
+                        auth_data.sa.token = tokens[1];
+                        auth_data.sa.token_exp = strtoul(tokens[2].c_str(), nullptr, 10);
+                        return true;
+                    }
+#endif
+                }
             }
 
             return false;
@@ -390,6 +430,17 @@ namespace gsheet
                         userfile.print(FPSTR(","));
                     }
                     userfile.print(String(auth_data.access_token.expire).c_str());
+#endif
+                    return true;
+                }
+                else if (type == token_type_sa_access_token)
+                {
+#if defined(GSHEET_ENABLE_SERVICE_AUTH)
+                    userfile.print(auth_data.sa.val[gsheet_sa_ns::cm].c_str());
+                    userfile.print(FPSTR(","));
+                    userfile.print(auth_data.sa.token.c_str());
+                    userfile.print(FPSTR(","));
+                    userfile.print(String(auth_data.sa.token_exp).c_str());
 #endif
                     return true;
                 }
@@ -515,9 +566,38 @@ namespace gsheet
                     data.auth_data_type = gsheet_user_auth_data_service_account;
                 }
             }
+
+            // Load the access token that was saved from previous session.
+            gsheet_file_config_data &tf = data.sa.token_file;
+            if (tf.initialized && tf.cb)
+            {
+                tf.cb(tf.file, tf.filename.c_str(), gsheet_file_mode_open_read);
+                if (tf.file)
+                {
+                    GSheetUserTokenFileParser::parseUserFile(GSheetUserTokenFileParser::token_type_sa_access_token, tf.file, data);
+                    tf.file.close();
+                }
+            }
 #endif
             return data;
         }
+
+        /**
+         * Set the file to keep the access token across restarts.
+         *
+         * @param tokenFile The token file config data e.g. getFile(fileConfig).
+         *
+         * The access token will be saved to this file once it was obtained.
+         * At initialization, the saved token will be used instead of requesting the new one when it is not expired.
+         * The time status callback is required to get the current timestamp.
+         */
+        void setTokenFile(gsheet_file_config_data &tokenFile)
+        {
+#if defined(GSHEET_ENABLE_FS)
+            if (tokenFile.initialized)
+                data.sa.token_file.copy(tokenFile);
+#endif
+        }
         bool isInitialized() { return data.sa.val[gsheet_sa_ns::cm].length() > 0 && data.sa.val[gsheet_sa_ns::pid].length() > 0 && data.sa.val[gsheet_sa_ns::pk].length() > 0; }
 
     private:
@@ -626,6 +706,8 @@ namespace gsheet
         gsheet_app_token_t app_token;
         GSheetAsyncResultCallback cb;
         GSheetAsyncResult *refResult = nullptr;
+        // The new token is being requested while the current token is still valid.
+        bool refreshing = false;
     };
 
 };
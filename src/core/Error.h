@@ -103,6 +103,7 @@ class GSheetError
 {
     friend class GSheetAsyncClientClass;
     friend class GSheetApp;
+    friend class GSheetBase;
 
 private:
     gsheet_app_error_t err;
@@ -42,12 +42,19 @@ namespace gsheet
     static GSheetJWTClass GSheetJWT;
 #endif
 
+    // The addresses of all GSheetApp objects, used for sharing the token between apps that use the same credentials.
+    // The list is shared by all translation units.
+    inline std::vector<uint32_t> &gsheet_app_list()
+    {
+        static std::vector<uint32_t> list;
+        return list;
+    }
+
     class GSheetApp : public GSheetAppBase, public GSheetResultBase
     {
         friend class GSheetClient;
 
     private:
-        uint16_t slot = 0;
         gsheet_async_data_item_t *sData = nullptr;
         auth_data_t auth_data;
         GSheetAsyncClientClass *aClient = nullptr;
@@ -57,7 +64,7 @@ namespace gsheet
         GSheetAsyncResultCallback resultCb = NULL;
         GSheetAsyncResult *refResult = nullptr;
         uint32_t ref_result_addr = 0;
-        GSheetTimer req_timer, auth_timer, err_timer, app_ready_timer;
+        GSheetTimer req_timer, auth_timer, err_timer, app_ready_timer, refresh_timer, share_timer;
         bool deinit = false;
         GSheetList vec;
         bool processing = false;
@@ -79,110 +86,85 @@ namespace gsheet
 
 #endif
 
-        bool parseItem(GSheetStringUtil &sut, const String &src, String &dest, const String &name, const String &delim, int &p1, int &p2)
-        {
-            sut.parse(src, name, delim, p1, p2);
-            if (p1 > -1 && p2 > -1)
-            {
-                if (src[p1] == '"')
-                    p1++;
-                if (src[p2] == '"')
-                    p2--;
-                dest = src.substring(p1, p2);
-                p1 = p2;
-                return true;
-            }
-            p1 = 0;
-            p2 = 0;
-            return false;
-        }
-
-        template <typename T = int>
-        bool parseItem(GSheetStringUtil &sut, const String &src, T &dest, const String &name, const String &delim, int &p1, int &p2)
-        {
-            sut.parse(src, name, delim, p1, p2);
-            if (p1 > -1 && p2 > -1)
-            {
-                if (src[p1] == '"')
-                    p1++;
-                if (src[p2] == '"')
-                    p2--;
-                dest = atoi(src.substring(p1, p2).c_str());
-                p1 = p2;
-                return true;
-            }
-            p1 = 0;
-            p2 = 0;
-            return false;
-        }
-
         bool parseToken(const String &payload)
         {
             GSheetStringUtil sut;
-            int p1 = 0, p2 = 0;
-            auth_data.app_token.clear();
+            // The token response members, they are located in a single scan without copying.
+            enum
+            {
+                f_error,
+                f_code,
+                f_message,
+                f_error_description,
+                f_localId,
+                f_idToken,
+                f_refreshToken,
+                f_expiresIn,
+                f_id_token,
+                f_refresh_token,
+                f_expires_in,
+                f_user_id,
+                f_access_token,
+                f_token_type,
+                f_max
+            };
+            static const char *const names[f_max] = {"error", "code", "message", "error_description", "localId", "idToken", "refreshToken", "expiresIn",
+                                                     "id_token", "refresh_token", "expires_in", "user_id", "access_token", "token_type"};
+            gsheet_json_span_t f[f_max];
+            const char *json = payload.c_str();
+            sut.scanJson(json, payload.length(), names, f_max, f);
+
+            // The new token is parsed to the temporary token and it replaces the current token only when succeeded.
+            // The expire is GSHEET_DEFAULT_TOKEN_TTL if it is not included in the response.
+            gsheet_app_token_t tk;
+            tk.clear();
             String token, refresh;
 
-            if (payload.indexOf("\"error\"") > -1)
+            if (f[f_error].found())
             {
                 String str;
-                if (parseItem(sut, payload, str, "\"error\"", ",", p1, p2))
-                {
-                    int code = 0;
-                    str = "";
-                    p1 = 0;
-                    p2 = 0;
-                    parseItem(sut, payload, code, "\"code\"", ",", p1, p2);
-                    parseItem(sut, payload, str, "\"message\"", ",", p1, p2);
-                    parseItem(sut, payload, str, "\"error_description\"", "}", p1, p2);
-                    if (str[str.length() - 1] == '"')
-                        str[str.length() - 1] = '\0';
-                    setLastError(sData ? &sData->aResult : nullptr, code, str);
-                }
+                const gsheet_json_span_t &msg = f[f_error_description].found() ? f[f_error_description] : (f[f_message].found() ? f[f_message] : f[f_error]);
+                if (msg.isString)
+                    sut.spanStr(json, msg, str);
+                setLastError(sData ? &sData->aResult : nullptr, sut.spanInt(json, f[f_code]), str);
             }
-            else if (payload.indexOf("\"idToken\"") > -1)
+            else if (f[f_idToken].found())
             {
-                parseItem(sut, payload, auth_data.app_token.val[gsheet_app_tk_ns::uid], "\"localId\"", ",", p1, p2);
-                p1 = 0;
-                p2 = 0;
-                sut.trim(auth_data.app_token.val[gsheet_app_tk_ns::uid]);
-                if (parseItem(sut, payload, token, "\"idToken\"", ",", p1, p2))
-                {
-                    sut.trim(token);
-                    parseItem(sut, payload, refresh, "\"refreshToken\"", ",", p1, p2);
-                    sut.trim(refresh);
-                    parseItem(sut, payload, auth_data.app_token.expire, "\"expiresIn\"", "}", p1, p2);
-                }
+                sut.spanStr(json, f[f_localId], tk.val[gsheet_app_tk_ns::uid]);
+                sut.spanStr(json, f[f_idToken], token);
+                sut.spanStr(json, f[f_refreshToken], refresh);
+                if (f[f_expiresIn].found())
+                    tk.expire = sut.spanInt(json, f[f_expiresIn]);
             }
-            else if (payload.indexOf("\"id_token\"") > -1)
+            else if (f[f_id_token].found())
             {
-                parseItem(sut, payload, auth_data.app_token.expire, "\"expires_in\"", ",", p1, p2);
-                parseItem(sut, payload, refresh, "\"refresh_token\"", ",", p1, p2);
-                parseItem(sut, payload, token, "\"id_token\"", ",", p1, p2);
-                parseItem(sut, payload, auth_data.app_token.val[gsheet_app_tk_ns::uid], "\"user_id\"", ",", p1, p2);
-                sut.trim(refresh);
-                sut.trim(token);
-                sut.trim(auth_data.app_token.val[gsheet_app_tk_ns::uid]);
+                sut.spanStr(json, f[f_user_id], tk.val[gsheet_app_tk_ns::uid]);
+                sut.spanStr(json, f[f_id_token], token);
+                sut.spanStr(json, f[f_refresh_token], refresh);
+                if (f[f_expires_in].found())
+                    tk.expire = sut.spanInt(json, f[f_expires_in]);
             }
-            else if (payload.indexOf("\"access_token\"") > -1)
+            else if (f[f_access_token].found())
             {
-                if (parseItem(sut, payload, token, "\"access_token\"", ",", p1, p2))
-                {
-                    parseItem(sut, payload, auth_data.app_token.expire, "\"expires_in\"", ",", p1, p2);
-                    parseItem(sut, payload, auth_data.app_token.val[gsheet_app_tk_ns::type], "\"token_type\"", "}", p1, p2);
-                }
+                sut.spanStr(json, f[f_access_token], token);
+                sut.spanStr(json, f[f_token_type], tk.val[gsheet_app_tk_ns::type]);
+                if (f[f_expires_in].found())
+                    tk.expire = sut.spanInt(json, f[f_expires_in]);
             }
 
-            if (token.length() > 0 && token[token.length() - 1] == '"')
-                token.remove(token.length() - 1, 1);
-
-            if (refresh.length() > 0 && refresh[refresh.length() - 1] == '"')
-                refresh.remove(refresh.length() - 1, 1);
+            if (token.length() == 0)
+            {
+                // Keep the current token in case background refresh.
+                if (!auth_data.refreshing)
+                    auth_data.app_token.clear();
+                return false;
+            }
 
-            auth_data.app_token.val[gsheet_app_tk_ns::token] = token;
-            auth_data.app_token.val[gsheet_app_tk_ns::refresh] = refresh;
-            auth_data.app_token.val[gsheet_app_tk_ns::pid] = auth_data.user_auth.sa.val[gsheet_sa_ns::pid];
-            return token.length() > 0;
+            tk.val[gsheet_app_tk_ns::token] = token;
+            tk.val[gsheet_app_tk_ns::refresh] = refresh;
+            tk.val[gsheet_app_tk_ns::pid] = auth_data.user_auth.sa.val[gsheet_sa_ns::pid];
+            auth_data.app_token = tk;
+            return true;
         }
 
         GSheetAsyncClientClass *getClient()
@@ -204,7 +186,9 @@ namespace gsheet
             if (event == gsheet_auth_event_error)
             {
                 err_timer.feed(5);
-                auth_timer.stop();
+                // The current token is still valid in case background refresh, retry after error timer timed out.
+                if (!auth_data.refreshing)
+                    auth_timer.stop();
             }
 
             setEventResult(sData ? &sData->aResult : getRefResult(), auth_data.user_auth.status.authEventString(auth_data.user_auth.status._event), auth_data.user_auth.status._event);
@@ -316,7 +300,6 @@ namespace gsheet
                 addContentTypeHeader(sData->request.val[gsheet_req_hndlr_ns::header], "application/json");
                 setContentLengthBase(aClient, sData, sData->request.val[gsheet_req_hndlr_ns::payload].length());
                 req_timer.feed(GSHEET_TCP_READ_TIMEOUT_SEC);
-                slot = slotCountBase(aClient) - 1;
 
                 setDebugBase(*getAppDebug(aClient), FPSTR("Connecting to server..."));
 
@@ -340,17 +323,169 @@ namespace gsheet
             if (!aClient)
                 return;
 
-            stopAsync(aClient, sData);
+            int index = slotIndexBase(aClient, sData);
+
+            // The connection is used by the first slot, the refresh request that is queued behind it should not close it.
+            if (index == 0 || (index < 0 && !auth_data.refreshing))
+                stopAsync(aClient, sData);
 
             if (sData)
             {
-                removeSlotBase(aClient, slot, false);
-                if (sData)
-                    delete sData;
+                if (index > -1)
+                    removeSlotBase(aClient, index, false);
+                delete sData;
                 sData = nullptr;
             }
+        }
 
-            sData = nullptr;
+        // Returns true when the new token should be requested in the background while the current token is still valid.
+        bool refreshDue()
+        {
+            if (isExpired() || !auth_data.app_token.authenticated)
+            {
+                auth_data.refreshing = false;
+                return false;
+            }
+
+            if (auth_data.refreshing)
+                return true;
+
+            if (!refresh_timer.isRunning() || refresh_timer.remaining() > 0)
+                return false;
+
+            if (auth_data.user_auth.auth_type == gsheet_auth_sa_access_token)
+                return true;
+#if defined(GSHEET_ENABLE_ACCESS_TOKEN)
+            if (auth_data.user_auth.auth_type == gsheet_auth_access_token)
+                return auth_data.user_auth.access_token.val[gsheet_access_tk_ns::refresh].length() > 0;
+#endif
+            return false;
+        }
+
+#if defined(GSHEET_ENABLE_SERVICE_AUTH)
+        // Apply the saved service account access token if it is still valid.
+        // Returns the remaining usable time in seconds of the token or 0 if it can't be used.
+        uint32_t loadToken()
+        {
+            gsheet_user_auth_data &ua = auth_data.user_auth;
+            uint32_t now = 0;
+            if (ua.sa.token.length() == 0 || !ua.timestatus_cb)
+                return 0;
+
+            ua.timestatus_cb(now);
+            if (now < GSHEET_DEFAULT_TS || ua.sa.token_exp <= now + 2 * 60)
+                return 0;
+
+            auth_data.app_token.val[gsheet_app_tk_ns::token] = ua.sa.token;
+            auth_data.app_token.val[gsheet_app_tk_ns::pid] = ua.sa.val[gsheet_sa_ns::pid];
+            auth_data.app_token.expire = ua.sa.token_exp - now;
+            auth_data.app_token.authenticated = true;
+            ua.status._event = gsheet_auth_event_ready;
+
+            uint32_t ttl = ua.sa.token_exp - now - 2 * 60;
+            return ua.sa.expire && ua.sa.expire < ttl ? ua.sa.expire : ttl;
+        }
+
+        // Save the service account access token and its expiry time to the token file.
+        void saveToken()
+        {
+#if defined(GSHEET_ENABLE_FS)
+            gsheet_user_auth_data &ua = auth_data.user_auth;
+            gsheet_file_config_data &tf = ua.sa.token_file;
+            uint32_t now = 0;
+            if (ua.auth_type != gsheet_auth_sa_access_token || !tf.initialized || !tf.cb || !ua.timestatus_cb)
+                return;
+
+            ua.timestatus_cb(now);
+            if (now < GSHEET_DEFAULT_TS)
+                return;
+
+            ua.sa.token = auth_data.app_token.val[gsheet_app_tk_ns::token];
+            ua.sa.token_exp = now + auth_data.app_token.expire;
+
+            tf.cb(tf.file, tf.filename.c_str(), gsheet_file_mode_open_write);
+            if (tf.file)
+            {
+                GSheetUserTokenFileParser::saveUserFile(GSheetUserTokenFileParser::token_type_sa_access_token, tf.file, ua);
+                tf.file.close();
+            }
+#endif
+        }
+#endif
+
+        // Returns true if the other app uses the same service account credentials (and scopes) as this app.
+        bool sameCredentials(GSheetApp *app)
+        {
+#if defined(GSHEET_ENABLE_SERVICE_AUTH)
+            return app && app != this && !app->deinit && app->auth_data.user_auth.auth_type == gsheet_auth_sa_access_token &&
+                   auth_data.user_auth.auth_type == gsheet_auth_sa_access_token &&
+                   app->auth_data.user_auth.sa.val[gsheet_sa_ns::cm] == auth_data.user_auth.sa.val[gsheet_sa_ns::cm];
+#else
+            (void)app;
+            return false;
+#endif
+        }
+
+        // Copy the token and its timers from the other app.
+        void adoptToken(GSheetApp *app)
+        {
+            auth_data.app_token = app->auth_data.app_token;
+            auth_timer.feed(app->auth_timer.remaining());
+            if (app->refresh_timer.isRunning())
+                refresh_timer.feed(app->refresh_timer.remaining());
+            auth_data.refreshing = false;
+            auth_data.user_auth.status._event = gsheet_auth_event_ready;
+            processing = false;
+            share_timer.stop();
+            if (getClient())
+                setAuthTsBase(aClient, millis());
+        }
+
+        // Use the valid token from the other app with the same credentials, or wait while its token request is in progress.
+        // Returns true if the token request of this app is not required.
+        bool shareToken()
+        {
+            for (size_t i = 0; i < gsheet_app_list().size(); i++)
+            {
+                GSheetApp *app = reinterpret_cast<GSheetApp *>(gsheet_app_list()[i]);
+                if (!sameCredentials(app))
+                    continue;
+
+                // The own token is requested when the other app could not get the token in time e.g. it is no longer looped.
+                if (app->processing)
+                {
+                    if (!share_timer.isRunning())
+                        share_timer.feed(GSHEET_TOKEN_SHARE_TIMEOUT_SEC);
+                    if (share_timer.remaining() > 0)
+                        return true;
+                    continue;
+                }
+
+                if (app->auth_data.app_token.authenticated && !app->auth_data.refreshing && !app->isExpired() &&
+                    app->auth_timer.remaining() > auth_timer.remaining() && (isExpired() || !app->refreshDue()))
+                {
+                    adoptToken(app);
+                    return true;
+                }
+            }
+            share_timer.stop();
+            return false;
+        }
+
+        // Install the new token to all apps that use the same credentials.
+        void notifyToken()
+        {
+            for (size_t i = 0; i < gsheet_app_list().size(); i++)
+            {
+                GSheetApp *app = reinterpret_cast<GSheetApp *>(gsheet_app_list()[i]);
+                if (sameCredentials(app) && !app->processing)
+                    app->adoptToken(this);
+            }
+        }
+
+        void feedRefreshTimer(uint32_t ttl)
+        {
+            refresh_timer.feed(ttl * GSHEET_TOKEN_REFRESH_PERCENT / 100);
         }
 
         bool processAuth()
@@ -378,18 +513,27 @@ namespace gsheet
 
             process(aClient, sData ? &sData->aResult : nullptr, resultCb);
 
-            if (!isExpired())
+            bool refresh = refreshDue();
+
+            if (!isExpired() && !refresh)
                 return true;
 
+            // The token was requested or already obtained by other app.
+            if (!processing && shareToken())
+                return !isExpired();
+
             if (!processing)
             {
-                if (auth_data.user_auth.auth_type == gsheet_auth_access_token && isExpired())
+                // The current token is kept in use while the new token is requested.
+                auth_data.refreshing = refresh;
+
+                if (auth_data.user_auth.auth_type == gsheet_auth_access_token && (isExpired() || refresh))
                 {
                     processing = true;
                     auth_data.user_auth.task_type = gsheet_core_auth_task_type_refresh_token;
                     setEvent(gsheet_auth_event_uninitialized);
                 }
-                else if ((auth_data.user_auth.status._event == gsheet_auth_event_error || auth_data.user_auth.status._event == gsheet_auth_event_ready) && (auth_data.app_token.expire == 0 || (auth_data.app_token.expire > 0 && isExpired())))
+                else if ((auth_data.user_auth.status._event == gsheet_auth_event_error || auth_data.user_auth.status._event == gsheet_auth_event_ready) && (auth_data.app_token.expire == 0 || (auth_data.app_token.expire > 0 && isExpired()) || refresh))
                 {
                     processing = true;
                     setEvent(gsheet_auth_event_uninitialized);
@@ -434,7 +578,8 @@ namespace gsheet
 #if defined(GSHEET_ENABLE_JWT)
                     if (auth_data.user_auth.sa.step == gsheet_jwt_step_begin)
                     {
-                        if (getClient())
+                        // Keep the connection of the requests that are in progress in case background refresh.
+                        if (getClient() && (sData || !auth_data.refreshing))
                             stop(aClient);
 
                         if (auth_data.user_auth.status._event != gsheet_auth_event_token_signing)
@@ -461,16 +606,25 @@ namespace gsheet
                     subdomain = auth_data.user_auth.auth_type == gsheet_auth_sa_access_token || auth_data.user_auth.auth_type == gsheet_auth_access_token ? FPSTR("oauth2") : FPSTR("identitytoolkit");
                     sop.async = true;
                     sop.auth_used = true;
+                    sop.queued = auth_data.refreshing;
 
                     // Remove all slots except sse in case ServiceAuth and CustomAuth to free up memory.
                     if (getClient())
                     {
-                        for (size_t i = slotCountBase(aClient) - 1; i == 0; i--)
-                            removeSlotBase(aClient, i, false);
+                        // The queued requests are still served with the current token in case background refresh.
+                        if (!auth_data.refreshing)
+                        {
+                            for (size_t i = slotCountBase(aClient) - 1; i == 0; i--)
+                                removeSlotBase(aClient, i, false);
+                        }
 
                         createSlot(aClient, sop);
                     }
 
+                    // The queue is full, the refresh request is created in the next loop.
+                    if (!sData)
+                        return auth_data.refreshing;
+
                     if (auth_data.user_auth.auth_type == gsheet_auth_sa_access_token)
                     {
 #if defined(GSHEET_ENABLE_SERVICE_AUTH)
@@ -507,6 +661,10 @@ namespace gsheet
             {
                 gsheet_sys_idle();
 
+                // The refresh request that is queued behind the pending requests is timed from when it is sent.
+                if (sData && auth_data.refreshing && sData->state == gsheet_async_state_undefined && slotIndexBase(aClient, sData) > 0)
+                    req_timer.feed(GSHEET_TCP_READ_TIMEOUT_SEC);
+
                 if (sData && ((sData->response.payloadLen > 0 && sData->aResult.error().code() != 0) || req_timer.remaining() == 0))
                 {
                     // In case of googleapis returns http status code >= 400 or request is timed out.
@@ -525,16 +683,25 @@ namespace gsheet
                             return false;
                     }
 
-                    if (parseToken(sData->response.val[gsheet_res_hndlr_ns::payload].c_str()))
+                    if (parseToken(sData->response.val[gsheet_res_hndlr_ns::payload]))
                     {
                         sData->response.val[gsheet_res_hndlr_ns::payload].remove(0, sData->response.val[gsheet_res_hndlr_ns::payload].length());
-                        auth_timer.feed(expire && expire < auth_data.app_token.expire ? expire : auth_data.app_token.expire - 2 * 60);
+                        uint32_t ttl = auth_data.app_token.expire > 2 * 60 ? auth_data.app_token.expire - 2 * 60 : auth_data.app_token.expire;
+                        if (expire && expire < auth_data.app_token.expire)
+                            ttl = expire;
+                        auth_timer.feed(ttl);
+                        feedRefreshTimer(ttl);
+                        auth_data.refreshing = false;
                         auth_data.app_token.authenticated = true;
                         if (getClient())
                             setAuthTsBase(aClient, millis());
                         auth_data.app_token.auth_type = auth_data.user_auth.auth_type;
                         auth_data.app_token.auth_data_type = auth_data.user_auth.auth_data_type;
+#if defined(GSHEET_ENABLE_SERVICE_AUTH)
+                        saveToken();
+#endif
                         setEvent(gsheet_auth_event_ready);
+                        notifyToken();
                         app_ready_timer.feed(1);
                     }
                     else
@@ -566,6 +733,7 @@ namespace gsheet
         {
             app_addr = reinterpret_cast<uint32_t>(this);
             vec.addRemoveList(aVec, app_addr, true);
+            vec.addRemoveList(gsheet_app_list(), app_addr, true);
         };
         ~GSheetApp()
         {
@@ -573,6 +741,7 @@ namespace gsheet
                 delete sData;
             sData = nullptr;
             vec.addRemoveList(aVec, app_addr, false);
+            vec.addRemoveList(gsheet_app_list(), app_addr, false);
         };
 
         /**
@@ -597,7 +766,12 @@ namespace gsheet
          *
          * @return bool Return true if the auth process was finished. Returns false if isExpired() returns true.
          */
-        bool ready() { return processAuth() && auth_data.app_token.authenticated; }
+        bool ready()
+        {
+            bool ret = processAuth();
+            // The current token is still valid while the new token is being requested in the background.
+            return (ret || auth_data.refreshing) && auth_data.app_token.authenticated;
+        }
 
         /**
          * Appy the authentication/authorization credentials to the Firebase services app.
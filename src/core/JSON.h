@@ -29,7 +29,9 @@
 #include <Client.h>
 #include "./GSheetConfig.h"
 #include "./core/Memory.h"
+#include "./core/Arena.h"
 #include "./core/StringUtil.h"
+#include "./core/NumberFormat.h"
 #include "./AsyncResult/Value.h"
 #include "./core/Core.h"
 #if __has_include(<stdarg.h>)
@@ -87,9 +89,8 @@ public:
     void addTokens(String &buf, const String &name, const String &value, bool last = false)
     {
         GSheetStringUtil sut;
-        char *p = new char[value.length() + 1];
-        memset(p, 0, value.length() + 1);
-        strcpy(p, value.c_str());
+        GSheetScratchArena scratch;
+        char *p = scratch.strdup(value);
         char *pp = p;
         char *end = p;
         String tmp;
@@ -106,7 +107,6 @@ public:
         }
         tmp += ']';
         addObject(buf, name, tmp, false, last);
-        delete p;
     }
 
     String toString(const String &value)
@@ -117,6 +117,47 @@ public:
         buf += '"';
         return buf;
     }
+
+    // Append the integer in JSON number.
+    void appendInt(String &out, int64_t value)
+    {
+        GSheetNumberFormat nf;
+        char b[24];
+        out.concat(b, nf.formatInt(b, value));
+    }
+
+    // Append the double in the shortest JSON number that reads back to the same value.
+    void appendDouble(String &out, double value)
+    {
+        GSheetNumberFormat nf;
+        char b[32];
+        out.concat(b, nf.formatDouble(b, value));
+    }
+
+    // Append the JSON string with the quotes, backslashes and control characters escaped.
+    void appendString(String &out, const char *s, size_t len)
+    {
+        static const char hex[] = "0123456789abcdef";
+        out += '"';
+        for (size_t i = 0; i < len; i++)
+        {
+            char c = s[i];
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += c;
+            }
+            else if ((uint8_t)c < 0x20)
+            {
+                out += FPSTR("\\u00");
+                out += hex[c >> 4];
+                out += hex[c & 0xf];
+            }
+            else
+                out += c;
+        }
+        out += '"';
+    }
 };
 
 class GSheetJsonWriter
@@ -126,9 +167,8 @@ private:
     int prek(gsheet_object_t &obj, const String &path)
     {
         GSheetStringUtil sut;
-        char *p = new char[path.length() + 1];
-        memset(p, 0, path.length() + 1);
-        strcpy(p, path.c_str());
+        GSheetScratchArena scratch;
+        char *p = scratch.strdup(path);
         char *pp = p;
         char *end = p;
         String tmp;
@@ -150,8 +190,6 @@ private:
             }
             pp = end;
         }
-
-        delete p;
         return i;
     }
     void ek(gsheet_object_t &obj, int i)
@@ -48,6 +48,28 @@ extern "C"
 };
 #endif
 
+static br_rsa_pkcs1_sign gsheet_jwt_rsa_signer(int backend)
+{
+#if defined(USE_LIB_SSL_ENGINE)
+    switch (backend)
+    {
+    case GSHEET_JWT_RSA_I15:
+        return &br_rsa_i15_pkcs1_sign;
+    case GSHEET_JWT_RSA_I31:
+        return &br_rsa_i31_pkcs1_sign;
+    case GSHEET_JWT_RSA_I32:
+        return &br_rsa_i32_pkcs1_sign;
+    case GSHEET_JWT_RSA_I62:
+        return br_rsa_i62_pkcs1_sign_get(); // null if not supported by platform
+    default:
+        return br_rsa_pkcs1_sign_get_default();
+    }
+#else
+    (void)backend;
+    return &br_rsa_i15_pkcs1_sign;
+#endif
+}
+
 GSheetJWTClass::GSheetJWTClass()
 {
     err_timer.feed(1);
@@ -58,6 +80,12 @@ GSheetJWTClass::GSheetJWTClass()
 
 GSheetJWTClass::~GSheetJWTClass()
 {
+#if defined(GSHEET_ENABLE_JWT_SIGN_TASK)
+    // The key and buffers are in use by the signing task
+    while (sign_state == gsheet_jwt_sign_state_running)
+        delay(1);
+#endif
+    freeKey();
 #if defined(USE_EMBED_SSL_ENGINE)
     stack_thunk_del_ref();
 #endif
@@ -141,9 +169,17 @@ bool GSheetJWTClass::begin(auth_data_t *auth_data)
 
     if (auth_data->user_auth.sa.step == gsheet_jwt_step_begin)
     {
+#if defined(GSHEET_ENABLE_JWT_SIGN_TASK)
+        // Wait for the previous signing task to finish and discard its result.
+        if (sign_state == gsheet_jwt_sign_state_running)
+            return true;
+        sign_state = gsheet_jwt_sign_state_idle;
+#endif
         processing = true;
         this->auth_data = auth_data;
-        this->auth_data->app_token.clear();
+        // Keep the current token in use until the new token is ready.
+        if (!this->auth_data->refreshing)
+            this->auth_data->app_token.clear();
         this->auth_data->user_auth.jwt_ts = millis();
         this->auth_data->user_auth.sa.step = gsheet_jwt_step_create_jwt;
         processing = false;
@@ -152,6 +188,195 @@ bool GSheetJWTClass::begin(auth_data_t *auth_data)
     return true;
 }
 
+#if defined(GSHEET_ENABLE_JWT_SIGN_TASK)
+void GSheetJWTClass::signTask(void *arg)
+{
+    GSheetJWTClass *jwt = static_cast<GSheetJWTClass *>(arg);
+    if (!jwt->rsa_sign)
+        jwt->selectSigner(jwt->sign_key);
+    jwt->sign_ret = jwt->rsa_sign(BR_HASH_OID_SHA256, (const unsigned char *)jwt->jwt_data.hash, br_sha256_SIZE, jwt->sign_key, jwt->jwt_data.signature);
+    jwt->sign_state = gsheet_jwt_sign_state_done;
+#if defined(GSHEET_JWT_SIGN_FREERTOS)
+    vTaskDelete(NULL);
+#endif
+}
+
+bool GSheetJWTClass::startSignTask(const br_rsa_private_key *key)
+{
+    sign_key = key;
+    sign_ret = 0;
+    sign_state = gsheet_jwt_sign_state_running;
+
+#if defined(GSHEET_JWT_SIGN_FREERTOS)
+    if (xTaskCreate(signTask, "gsheet_jwt_sign", GSHEET_JWT_SIGN_TASK_STACK_SIZE, this, GSHEET_JWT_SIGN_TASK_PRIORITY, NULL) == pdPASS)
+        return true;
+#elif defined(GSHEET_JWT_SIGN_THREAD)
+    std::thread(signTask, this).detach();
+    return true;
+#endif
+
+    // Fallback to sign in the caller
+    sign_state = gsheet_jwt_sign_state_idle;
+    return false;
+}
+#endif
+
+int GSheetJWTClass::benchmarkKey(const br_rsa_private_key *key, Print *out)
+{
+    static const char *names[] = {"default", "i15", "i31", "i32", "i62"};
+    unsigned char hash[br_sha256_SIZE];
+    unsigned char *sig = reinterpret_cast<unsigned char *>(mem.alloc((key->n_bitlen + 7) / 8));
+    int selected = -1;
+    unsigned long best = 0;
+
+    memset(hash, 0x5a, sizeof(hash));
+
+    for (int i = GSHEET_JWT_RSA_I15; i <= GSHEET_JWT_RSA_I62; i++)
+    {
+        br_rsa_pkcs1_sign fn = gsheet_jwt_rsa_signer(i);
+        // Skip unsupported and duplicate (fallback) implementations
+        if (!fn || (i > GSHEET_JWT_RSA_I15 && fn == gsheet_jwt_rsa_signer(GSHEET_JWT_RSA_I15)))
+            continue;
+
+        gsheet_sys_idle();
+        unsigned long us = micros();
+        uint32_t ret = fn(BR_HASH_OID_SHA256, hash, sizeof(hash), key, sig);
+        us = micros() - us;
+
+        if (out)
+        {
+            out->print(names[i]);
+            out->print(FPSTR(": "));
+            out->print(ret ? String(us) : String(FPSTR("failed")));
+            out->println(ret ? FPSTR(" us") : FPSTR(""));
+        }
+
+        if (ret && (selected < 0 || us < best))
+        {
+            selected = i;
+            best = us;
+        }
+    }
+
+    mem.release(&sig);
+
+    return selected;
+}
+
+void GSheetJWTClass::selectSigner(const br_rsa_private_key *key)
+{
+#if GSHEET_JWT_RSA_BACKEND == GSHEET_JWT_RSA_AUTO
+    int selected = benchmarkKey(key, nullptr);
+    if (selected > -1)
+        rsa_sign = gsheet_jwt_rsa_signer(selected);
+#else
+    (void)key;
+#endif
+    if (!rsa_sign)
+        rsa_sign = gsheet_jwt_rsa_signer(GSHEET_JWT_RSA_BACKEND);
+    if (!rsa_sign)
+        rsa_sign = gsheet_jwt_rsa_signer(GSHEET_JWT_RSA_DEFAULT);
+}
+
+int GSheetJWTClass::benchmarkRSA(const String &privateKey, Print *out)
+{
+    // The running sign task uses the cached key and the signer, they are not changed until it is done.
+    if (signing())
+        return -1;
+
+    // The key is parsed locally, the cached key of the signing is kept.
+    PrivateKey pk(privateKey.c_str());
+    if (!pk.isRSA())
+        return -1;
+    int selected = benchmarkKey(pk.getRSA(), out);
+    if (selected > -1 && !signing())
+        rsa_sign = gsheet_jwt_rsa_signer(selected);
+    return selected;
+}
+
+void GSheetJWTClass::freeKey()
+{
+    if (pk_cache)
+        delete pk_cache;
+    pk_cache = nullptr;
+    memset(pk_digest, 0, sizeof(pk_digest));
+}
+
+PrivateKey *GSheetJWTClass::getKey(const String &pem)
+{
+    // The PEM decoding and key parsing are done only when the key was changed.
+    uint8_t digest[32];
+    br_sha256_context mc;
+    br_sha256_init(&mc);
+    br_sha256_update(&mc, pem.c_str(), pem.length());
+    br_sha256_out(&mc, digest);
+
+    if (pk_cache && memcmp(digest, pk_digest, sizeof(digest)) == 0)
+        return pk_cache;
+
+    freeKey();
+    pk_cache = new PrivateKey(pem.c_str());
+    if (pk_cache)
+        memcpy(pk_digest, digest, sizeof(digest));
+    return pk_cache;
+}
+
+void GSheetJWTClass::buildClaims()
+{
+    // The claims are built from the client email and auth type, the scope is constant.
+    if (claims_prefix.length() && claims_auth_type == (int)auth_data->user_auth.auth_type && claims_iss == auth_data->user_auth.sa.val[gsheet_sa_ns::cm])
+        return;
+
+    claims_iss = auth_data->user_auth.sa.val[gsheet_sa_ns::cm];
+    claims_auth_type = auth_data->user_auth.auth_type;
+    claims_prefix.remove(0, claims_prefix.length());
+    claims_suffix.remove(0, claims_suffix.length());
+
+    json.addObject(claims_prefix, "iss", claims_iss, true);
+    json.addObject(claims_prefix, "sub", claims_iss, true);
+
+    String t = FPSTR("https://");
+    if (auth_data->user_auth.auth_type == gsheet_auth_sa_access_token)
+    {
+        jwt_add_gapis_host(t, "oauth2");
+        t += FPSTR("/token");
+    }
+
+    json.addObject(claims_prefix, "aud", t, true);
+
+    if (auth_data->user_auth.auth_type == gsheet_auth_sa_access_token)
+    {
+        String buri;
+        String host;
+        jwt_add_gapis_host(host, "www");
+        uut.host2Url(buri, host);
+        buri += FPSTR("/auth/");
+
+        String s = buri; // https://www.googleapis.com/auth/
+        s += FPSTR("devstorage.full_control");
+        jwt_add_sp(s);
+        s += buri; // https://www.googleapis.com/auth/
+        s += FPSTR("datastore");
+        jwt_add_sp(s);
+        s += buri; // https://www.googleapis.com/auth/
+        s += FPSTR("userinfo.email");
+        jwt_add_sp(s);
+        s += buri; // https://www.googleapis.com/auth/
+        s += FPSTR("firebase.database");
+        jwt_add_sp(s);
+        s += buri; // https://www.googleapis.com/auth/
+        s += FPSTR("cloud-platform");
+        jwt_add_sp(s);
+        s += buri; // https://www.googleapis.com/auth/
+        s += FPSTR("iam");
+
+        // ,"scope":"<scope>"}
+        claims_suffix = FPSTR(",\"scope\":\"");
+        claims_suffix += s;
+        claims_suffix += FPSTR("\"}");
+    }
+}
+
 bool GSheetJWTClass::create()
 {
 
@@ -193,50 +418,11 @@ bool GSheetJWTClass::create()
         // {"iss":"<email>","sub":"<email>","aud":"<audience>","iat":<timstamp>,"exp":<expire>,"scope":"<scope>"}
         // {"iss":"<email>","sub":"<email>","aud":"<audience>","iat":<timstamp>,"exp":<expire>,"uid":"<uid>","claims":"<claims>"}
 
-        json.addObject(payload, "iss", auth_data->user_auth.sa.val[gsheet_sa_ns::cm], true);
-        json.addObject(payload, "sub", auth_data->user_auth.sa.val[gsheet_sa_ns::cm], true);
-
-        String t = FPSTR("https://");
-        if (auth_data->user_auth.auth_type == gsheet_auth_sa_access_token)
-        {
-            jwt_add_gapis_host(t, "oauth2");
-            t += FPSTR("/token");
-        }
-
-        json.addObject(payload, "aud", t, true);
-        t.remove(0, t.length());
+        buildClaims();
+        payload = claims_prefix;
         json.addObject(payload, "iat", String(now), false);
         json.addObject(payload, "exp", String((int)(now + 3600)), false);
-
-        if (auth_data->user_auth.auth_type == gsheet_auth_sa_access_token)
-        {
-            String buri;
-            String host;
-            jwt_add_gapis_host(host, "www");
-            uut.host2Url(buri, host);
-            buri += FPSTR("/auth/");
-
-            String s = buri; // https://www.googleapis.com/auth/
-            s += FPSTR("devstorage.full_control");
-            jwt_add_sp(s);
-            s += buri; // https://www.googleapis.com/auth/
-            s += FPSTR("datastore");
-            jwt_add_sp(s);
-            s += buri; // https://www.googleapis.com/auth/
-            s += FPSTR("userinfo.email");
-            jwt_add_sp(s);
-            s += buri; // https://www.googleapis.com/auth/
-            s += FPSTR("firebase.database");
-            jwt_add_sp(s);
-            s += buri; // https://www.googleapis.com/auth/
-            s += FPSTR("cloud-platform");
-            jwt_add_sp(s);
-            s += buri; // https://www.googleapis.com/auth/
-            s += FPSTR("iam");
-            buri.remove(0, buri.length());
-
-            json.addObject(payload, "scope", s, true, true);
-        }
+        payload += claims_suffix;
 
         len = but.encodedLength(payload.length());
         char *buf = reinterpret_cast<char *>(mem.alloc(len));
@@ -259,44 +445,70 @@ bool GSheetJWTClass::create()
     }
     else if (auth_data->user_auth.sa.step == gsheet_jwt_step_sign)
     {
-        // RSA private key
-        PrivateKey *pk = nullptr;
-        gsheet_sys_idle();
-        
-        // parse priv key
-        if (jwt_data.pk.length() > 0)
-            pk = new PrivateKey(jwt_data.pk.c_str());
-        else if (auth_data->user_auth.sa.val[gsheet_sa_ns::pk].length() > 0)
-            pk = new PrivateKey(auth_data->user_auth.sa.val[gsheet_sa_ns::pk].c_str());
+        int ret = 0;
 
-        jwt_data.pk.remove(0, jwt_data.pk.length());
+#if defined(GSHEET_ENABLE_JWT_SIGN_TASK)
+        // Await the signing task
+        if (sign_state == gsheet_jwt_sign_state_running)
+            return true;
 
-        if (!pk)
+        if (sign_state == gsheet_jwt_sign_state_done)
         {
-            jwt_data.err_code = GSHEET_ERROR_TOKEN_PARSE_PK;
-            jwt_data.msg = (const char *)FPSTR("JWT, private key parsing fail");
-            auth_data->user_auth.sa.step = gsheet_jwt_step_error;
-            return exit(false);
+            sign_state = gsheet_jwt_sign_state_idle;
+            ret = sign_ret;
         }
-
-        if (!pk->isRSA())
+        else
+#endif
         {
-            delete pk;
+            // RSA private key
+            PrivateKey *pk = nullptr;
+            gsheet_sys_idle();
+
+            // parse priv key or use the cached one
+            if (jwt_data.pk.length() > 0)
+                pk = getKey(jwt_data.pk);
+            else if (auth_data->user_auth.sa.val[gsheet_sa_ns::pk].length() > 0)
+                pk = getKey(auth_data->user_auth.sa.val[gsheet_sa_ns::pk]);
+
+            jwt_data.pk.remove(0, jwt_data.pk.length());
+
+            if (!pk)
+            {
+                jwt_data.err_code = GSHEET_ERROR_TOKEN_PARSE_PK;
+                jwt_data.msg = (const char *)FPSTR("JWT, private key parsing fail");
+                auth_data->user_auth.sa.step = gsheet_jwt_step_error;
+                return exit(false);
+            }
+
+            if (!pk->isRSA())
+            {
+                freeKey();
+                pk = nullptr;
+                jwt_data.err_code = GSHEET_ERROR_TOKEN_PARSE_PK;
+                jwt_data.msg = (const char *)FPSTR("JWT, invalid RSA private key");
+                auth_data->user_auth.sa.step = gsheet_jwt_step_error;
+                return exit(false);
+            }
+
+            // The parsed key is kept for the next signing
+            const br_rsa_private_key *br_rsa_key = pk->getRSA();
             pk = nullptr;
-            jwt_data.err_code = GSHEET_ERROR_TOKEN_PARSE_PK;
-            jwt_data.msg = (const char *)FPSTR("JWT, invalid RSA private key");
-            auth_data->user_auth.sa.step = gsheet_jwt_step_error;
-            return exit(false);
-        }
 
-        const br_rsa_private_key *br_rsa_key = pk->getRSA();
+            // generate RSA signature from private key and message digest
+            gsheet_sys_idle();
+            if (!jwt_data.signature)
+                jwt_data.signature = reinterpret_cast<unsigned char *>(mem.alloc(256));
 
-        // generate RSA signature from private key and message digest
-        gsheet_sys_idle();
-        if (!jwt_data.signature)
-            jwt_data.signature = reinterpret_cast<unsigned char *>(mem.alloc(256));
-        int ret = br_rsa_i15_pkcs1_sign(BR_HASH_OID_SHA256, (const unsigned char *)jwt_data.hash, br_sha256_SIZE, br_rsa_key, jwt_data.signature);
-        gsheet_sys_idle();
+#if defined(GSHEET_ENABLE_JWT_SIGN_TASK)
+            // The result will be taken in the next call, the RSA implementation is also selected by the task.
+            if (startSignTask(br_rsa_key))
+                return true;
+#endif
+            if (!rsa_sign)
+                selectSigner(br_rsa_key);
+            ret = rsa_sign(BR_HASH_OID_SHA256, (const unsigned char *)jwt_data.hash, br_sha256_SIZE, br_rsa_key, jwt_data.signature);
+            gsheet_sys_idle();
+        }
 
         if (jwt_data.hash)
             mem.release(&jwt_data.hash);
@@ -305,9 +517,6 @@ bool GSheetJWTClass::create()
         char *buf = reinterpret_cast<char *>(mem.alloc(len));
         but.encodeUrl(mem, buf, jwt_data.signature, 256);
 
-        delete pk;
-        pk = nullptr;
-
         // get the signed JWT
         if (ret > 0)
         {
@@ -38,6 +38,13 @@
 
 #if defined(GSHEET_ENABLE_JWT)
 
+#if defined(GSHEET_ENABLE_JWT_SIGN_TASK)
+#include <atomic>
+#if defined(GSHEET_JWT_SIGN_THREAD)
+#include <thread>
+#endif
+#endif
+
 #if __has_include(<ESP_SSLClient.h>)
 #include <ESP_SSLClient.h>
 #else
@@ -57,6 +64,15 @@ namespace gsheet
     }
     static void jwt_add_sp(String &buf) { buf += ' '; }
 
+#if defined(GSHEET_ENABLE_JWT_SIGN_TASK)
+    enum gsheet_jwt_sign_state
+    {
+        gsheet_jwt_sign_state_idle,
+        gsheet_jwt_sign_state_running,
+        gsheet_jwt_sign_state_done
+    };
+#endif
+
     struct jwt_token_data_t
     {
     public:
@@ -86,6 +102,35 @@ namespace gsheet
         bool processing = false;
         gsheet_app_debug_t *app_debug = nullptr;
 
+        // The parsed RSA private key and the SHA256 digest of its PEM, kept across signings
+        PrivateKey *pk_cache = nullptr;
+        uint8_t pk_digest[32];
+
+        // The selected RSA PKCS#1 signing implementation
+        br_rsa_pkcs1_sign rsa_sign = nullptr;
+
+        // The constant parts of JWT claims, only iat and exp are changed in every token
+        String claims_iss, claims_prefix, claims_suffix;
+        int claims_auth_type = -1;
+
+#if defined(GSHEET_ENABLE_JWT_SIGN_TASK)
+        // The state and result of the signing task, the state is set by the signing task when it's done.
+        std::atomic<uint8_t> sign_state{gsheet_jwt_sign_state_idle};
+        int sign_ret = 0;
+        const br_rsa_private_key *sign_key = nullptr;
+        static void signTask(void *arg);
+        bool startSignTask(const br_rsa_private_key *key);
+#endif
+
+        bool signing() const
+        {
+#if defined(GSHEET_ENABLE_JWT_SIGN_TASK)
+            return sign_state == gsheet_jwt_sign_state_running;
+#else
+            return false;
+#endif
+        }
+
         bool exit(bool ret)
         {
             processing = false;
@@ -98,6 +143,11 @@ namespace gsheet
 
         bool begin(auth_data_t *auth_data);
         bool create();
+        void buildClaims();
+        PrivateKey *getKey(const String &pem);
+        void freeKey();
+        int benchmarkKey(const br_rsa_private_key *key, Print *out);
+        void selectSigner(const br_rsa_private_key *key);
         void sendErrCB(GSheetAsyncResultCallback cb, GSheetAsyncResult *aResult = nullptr);
         void sendErrResult(GSheetAsyncResult *refResult);
         void setAppDebug(gsheet_app_debug_t *app_debug);
@@ -115,6 +165,16 @@ namespace gsheet
          * @return boolean of JWT processor result.
          */
         bool loop(auth_data_t *auth_data);
+
+        /**
+         * Measure the signing time of each RSA implementation with the private key
+         * and use the fastest one for the JWT signing.
+         *
+         * @param privateKey The service account RSA private key.
+         * @param out The optional Print object e.g. Serial to print the signing time of each implementation.
+         * @return integer value of the selected implementation e.g. GSHEET_JWT_RSA_I31 or -1 if key is invalid.
+         */
+        int benchmarkRSA(const String &privateKey, Print *out = nullptr);
     };
 
 }
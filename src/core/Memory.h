@@ -36,9 +36,163 @@
 #endif
 #endif
 
+#if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+#include <esp_heap_caps.h>
+#endif
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#elif !defined(ARDUINO) && __has_include(<mutex>)
+#include <mutex>
+#define GSHEET_MEMORY_USE_STD_MUTEX
+#endif
+
+// The maximum number of the released blocks that are kept in each size class for reuse (0 to disable).
+#if !defined(GSHEET_MEMORY_POOL_SIZE)
+#define GSHEET_MEMORY_POOL_SIZE 4
+#endif
+
+// The minimum size of bulk buffers which are placed in PSRAM (or ESP8266 external heap) when available.
+#if !defined(GSHEET_MEMORY_PSRAM_MIN_SIZE)
+#define GSHEET_MEMORY_PSRAM_MIN_SIZE 1024
+#endif
+
+// The size classes of the pooled blocks, the URL token, base64 decoding, base64 chunk and payload chunk buffers.
+// The sizes are the reserved lengths (see getReservedLen) of the 64, 256, 1024 and 2048 bytes buffers.
+#define GSHEET_MEMORY_POOL_CLASSES 4
+#define GSHEET_MEMORY_POOL_CLASS_SIZES {68, 260, 1028, 2052}
+
+enum gsheet_mem_placement
+{
+    gsheet_mem_placement_auto,    // PSRAM for bulk buffers, internal RAM for small buffers
+    gsheet_mem_placement_internal,
+    gsheet_mem_placement_psram
+};
+
+struct gsheet_memory_stats_t
+{
+    uint32_t allocs = 0;      // the number of allocations
+    uint32_t frees = 0;       // the number of releases
+    uint32_t pool_hits = 0;   // the allocations served from the pool
+    uint32_t failures = 0;    // the failed allocations
+    uint32_t psram_allocs = 0;
+    size_t in_use = 0;        // the bytes currently allocated
+    size_t peak = 0;          // the maximum of in_use
+    size_t pooled = 0;        // the bytes of released blocks kept in the pool
+};
+
 class GSheetMemory
 {
 private:
+    // The block header, keeps the allocation aligned to 8 bytes.
+    struct block_t
+    {
+        union
+        {
+            block_t *next; // the next free block in pool
+            size_t size;   // the usable size of allocated block
+        };
+        uint8_t cls; // size class or 0xff for unpooled block
+        uint8_t psram;
+    };
+
+    struct pool_t
+    {
+        block_t *free[GSHEET_MEMORY_POOL_CLASSES][2] = {}; // per class and placement
+        uint8_t count[GSHEET_MEMORY_POOL_CLASSES][2] = {};
+        gsheet_memory_stats_t stats;
+#if defined(ESP32)
+        portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+#elif defined(GSHEET_MEMORY_USE_STD_MUTEX)
+        std::mutex mux;
+#endif
+    };
+
+    static pool_t &pool()
+    {
+        static pool_t p;
+        return p;
+    }
+
+    // The pool is shared by the tasks e.g. the async clients in different FreeRTOS tasks.
+    // Only the free lists and stats are guarded, the system allocation is done outside the lock.
+    static void lock(pool_t &pl)
+    {
+#if defined(ESP32)
+        portENTER_CRITICAL(&pl.mux);
+#elif defined(GSHEET_MEMORY_USE_STD_MUTEX)
+        pl.mux.lock();
+#else
+        (void)pl;
+#endif
+    }
+
+    static void unlock(pool_t &pl)
+    {
+#if defined(ESP32)
+        portEXIT_CRITICAL(&pl.mux);
+#elif defined(GSHEET_MEMORY_USE_STD_MUTEX)
+        pl.mux.unlock();
+#else
+        (void)pl;
+#endif
+    }
+
+    static size_t headerLen() { return (sizeof(block_t) + 7) & ~(size_t)7; }
+
+    static int sizeClass(size_t len)
+    {
+        static const size_t sizes[GSHEET_MEMORY_POOL_CLASSES] = GSHEET_MEMORY_POOL_CLASS_SIZES;
+        for (int i = 0; i < GSHEET_MEMORY_POOL_CLASSES; i++)
+        {
+            if (len <= sizes[i])
+                return i;
+        }
+        return -1;
+    }
+
+    static size_t classSize(int cls)
+    {
+        static const size_t sizes[GSHEET_MEMORY_POOL_CLASSES] = GSHEET_MEMORY_POOL_CLASS_SIZES;
+        return sizes[cls];
+    }
+
+    static bool usePSRAM(size_t len, gsheet_mem_placement placement)
+    {
+#if defined(BOARD_HAS_PSRAM)
+        if (ESP.getPsramSize() == 0)
+            return false;
+#elif !defined(ESP8266_USE_EXTERNAL_HEAP)
+        return false;
+#endif
+        return placement == gsheet_mem_placement_psram || (placement == gsheet_mem_placement_auto && len >= GSHEET_MEMORY_PSRAM_MIN_SIZE);
+    }
+
+    static void *sysAlloc(size_t len, bool psram)
+    {
+        void *p = nullptr;
+#if defined(BOARD_HAS_PSRAM)
+        if (psram)
+            p = ps_malloc(len);
+        else
+            p = heap_caps_malloc(len, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#elif defined(ESP8266_USE_EXTERNAL_HEAP)
+        if (psram)
+            ESP.setExternalHeap();
+        p = malloc(len);
+        if (psram)
+            ESP.resetHeap();
+#else
+        (void)psram;
+        p = malloc(len);
+#endif
+        return p;
+    }
+
+    static void *data(block_t *b) { return reinterpret_cast<uint8_t *>(b) + headerLen(); }
+
+    static block_t *header(void *p) { return reinterpret_cast<block_t *>(reinterpret_cast<uint8_t *>(p) - headerLen()); }
+
 public:
     GSheetMemory() {}
     ~GSheetMemory() {}
@@ -49,38 +203,94 @@ public:
         void **p = (void **)ptr;
         if (*p)
         {
-            free(*p);
+            pool_t &pl = pool();
+            block_t *b = header(*p);
+            size_t size = b->cls == 0xff ? b->size : classSize(b->cls);
+            lock(pl);
+            pl.stats.frees++;
+            pl.stats.in_use -= size;
+
+            if (b->cls != 0xff && pl.count[b->cls][b->psram] < GSHEET_MEMORY_POOL_SIZE)
+            {
+                b->next = pl.free[b->cls][b->psram];
+                pl.free[b->cls][b->psram] = b;
+                pl.count[b->cls][b->psram]++;
+                pl.stats.pooled += size;
+                b = nullptr;
+            }
+            unlock(pl);
+            if (b)
+                free(b);
             *p = 0;
         }
     }
 
-    void *alloc(size_t len, bool clear = true)
+    /**
+     * Allocate memory.
+     *
+     * @param len The length of memory to allocate.
+     * @param clear The option to clear the memory.
+     * @param placement The gsheet_mem_placement enum for the memory placement.
+     * @return The pointer to memory or NULL if out of memory.
+     */
+    void *alloc(size_t len, bool clear = true, gsheet_mem_placement placement = gsheet_mem_placement_auto)
     {
-        void *p;
+        pool_t &pl = pool();
         size_t newLen = getReservedLen(len);
-#if defined(BOARD_HAS_PSRAM)
-        if (ESP.getPsramSize() > 0)
-            p = (void *)ps_malloc(newLen);
-        else
-            p = (void *)malloc(newLen);
+        int cls = GSHEET_MEMORY_POOL_SIZE > 0 ? sizeClass(newLen) : -1;
+        if (cls > -1)
+            newLen = classSize(cls);
 
-        if (!p)
-            return NULL;
-#else
+        bool psram = usePSRAM(newLen, placement);
+        block_t *b = nullptr;
 
-#if defined(ESP8266_USE_EXTERNAL_HEAP)
-        ESP.setExternalHeap();
-#endif
-        p = (void *)malloc(newLen);
-        bool nn = p ? true : false;
-#if defined(ESP8266_USE_EXTERNAL_HEAP)
-        ESP.resetHeap();
-#endif
+        if (cls > -1)
+        {
+            lock(pl);
+            b = pl.free[cls][psram];
+            if (b)
+            {
+                pl.free[cls][psram] = b->next;
+                pl.count[cls][psram]--;
+                pl.stats.pooled -= newLen;
+                pl.stats.pool_hits++;
+            }
+            unlock(pl);
+        }
+
+        if (!b)
+        {
+            b = reinterpret_cast<block_t *>(sysAlloc(headerLen() + newLen, psram));
+            // Fallback to the other memory.
+            if (!b && placement == gsheet_mem_placement_auto)
+            {
+                psram = !psram && usePSRAM(newLen, gsheet_mem_placement_psram);
+                b = reinterpret_cast<block_t *>(sysAlloc(headerLen() + newLen, psram));
+            }
+        }
 
-        if (!nn)
+        if (!b)
+        {
+            lock(pl);
+            pl.stats.failures++;
+            unlock(pl);
             return NULL;
+        }
 
-#endif
+        b->size = newLen;
+        b->cls = cls > -1 ? cls : 0xff;
+        b->psram = psram;
+
+        lock(pl);
+        pl.stats.allocs++;
+        if (psram)
+            pl.stats.psram_allocs++;
+        pl.stats.in_use += newLen;
+        if (pl.stats.in_use > pl.stats.peak)
+            pl.stats.peak = pl.stats.in_use;
+        unlock(pl);
+
+        void *p = data(b);
         if (clear)
             memset(p, 0, newLen);
         return p;
@@ -94,6 +304,54 @@ public:
             newlen += 4;
         return (size_t)newlen;
     }
+
+    /**
+     * Get the memory allocation statistics.
+     *
+     * @return gsheet_memory_stats_t The statistics.
+     */
+    static gsheet_memory_stats_t stats()
+    {
+        pool_t &pl = pool();
+        lock(pl);
+        gsheet_memory_stats_t s = pl.stats;
+        unlock(pl);
+        return s;
+    }
+
+    /**
+     * Free all released blocks that kept in the pool.
+     */
+    static void trim()
+    {
+        pool_t &pl = pool();
+        block_t *list = nullptr;
+        lock(pl);
+        for (int i = 0; i < GSHEET_MEMORY_POOL_CLASSES; i++)
+        {
+            for (int j = 0; j < 2; j++)
+            {
+                while (pl.free[i][j])
+                {
+                    block_t *b = pl.free[i][j];
+                    pl.free[i][j] = b->next;
+                    b->next = list;
+                    list = b;
+                }
+                pl.count[i][j] = 0;
+            }
+        }
+        pl.stats.pooled = 0;
+        unlock(pl);
+
+        // The blocks are freed outside the lock.
+        while (list)
+        {
+            block_t *b = list;
+            list = b->next;
+            free(b);
+        }
+    }
 };
 
 #endif
\ No newline at end of file
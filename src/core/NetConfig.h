@@ -32,6 +32,19 @@
 
 #define GSHEET_NET_RECONNECT_TIMEOUT_SEC 10000
 
+// The interval to poll the network link status between the network events.
+#if !defined(GSHEET_NET_STATUS_POLL_INTERVAL_MS)
+#define GSHEET_NET_STATUS_POLL_INTERVAL_MS 1000
+#endif
+
+// Counts the network events, the cached link status is invalid when it was changed.
+// The counter is shared by all translation units.
+inline volatile uint32_t &gsheet_net_link_events()
+{
+    static volatile uint32_t events = 0;
+    return events;
+}
+
 struct gsheet_network_config_data
 {
     friend class GSheetDefaultNetwork;
@@ -153,6 +166,10 @@ private:
     bool initialized = false;
     bool network_status = false;
     bool reconnect = true;
+    // The network_status is valid until the next event or polling interval.
+    bool status_valid = false;
+    uint32_t status_events = 0;
+    unsigned long status_ms = 0;
     GSheetWiFi *wifi = nullptr;
     GSheetTimer net_timer;
     GSheetTimer eth_timer;
@@ -203,6 +220,7 @@ public:
         initialized = false;
         network_status = false;
         reconnect = true;
+        status_valid = false;
         wifi = nullptr;
 #if defined(GSHEET_LWIP_ETH_IS_AVAILABLE) && defined(GSHEET_ENABLE_ETHERNET_NETWORK)
         eth = NULL;
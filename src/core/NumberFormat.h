@@ -0,0 +1,331 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2026 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef GSHEET_CORE_NUMBER_FORMAT_H
+#define GSHEET_CORE_NUMBER_FORMAT_H
+
+#include <Arduino.h>
+
+/**
+ * Format the numbers in JSON without the printf.
+ *
+ * The double is formatted in the shortest digits that read back to the same value with the Grisu2 algorithm
+ * (Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers", PLDI 2010).
+ * The output always round-trips and it is the shortest for almost all values, the few others have one more digit.
+ */
+class GSheetNumberFormat
+{
+private:
+    // The normalized 64-bit significand and binary exponent of floating point number.
+    struct gsheet_diy_fp_t
+    {
+        uint64_t f = 0;
+        int e = 0;
+        gsheet_diy_fp_t() {}
+        gsheet_diy_fp_t(uint64_t f, int e) : f(f), e(e) {}
+    };
+
+    static const uint64_t hiddenBit = 0x0010000000000000ULL;
+
+    gsheet_diy_fp_t mul(const gsheet_diy_fp_t &x, const gsheet_diy_fp_t &y)
+    {
+        const uint64_t m32 = 0xFFFFFFFFULL;
+        uint64_t a = x.f >> 32, b = x.f & m32, c = y.f >> 32, d = y.f & m32;
+        uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+        uint64_t tmp = (bd >> 32) + (ad & m32) + (bc & m32);
+        tmp += 1ULL << 31; // round
+        return gsheet_diy_fp_t(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64);
+    }
+
+    gsheet_diy_fp_t normalize(gsheet_diy_fp_t v)
+    {
+        while (!(v.f & 0x8000000000000000ULL))
+        {
+            v.f <<= 1;
+            v.e--;
+        }
+        return v;
+    }
+
+    // The cached power of ten 10^-K that brings the product exponent into [-60, -32].
+    gsheet_diy_fp_t cachedPower(int e, int &K)
+    {
+        static const uint64_t f[] = {
+            0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+            0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+            0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+            0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+            0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+            0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+            0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+            0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+            0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+            0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+            0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+            0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+            0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+            0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+            0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+            0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+            0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+            0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+            0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+            0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+            0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+            0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+        };
+        static const int16_t x[] = {
+            -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927, -901, -874, -847, -821,
+            -794, -768, -741, -715, -688, -661, -635, -608, -582, -555, -529, -502, -475, -449, -422, -396,
+            -369, -343, -316, -289, -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+            56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348, 375, 402, 428, 455,
+            481, 508, 534, 561, 588, 614, 641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+            907, 933, 960, 986, 1013, 1039, 1066,
+        };
+
+        double dk = (-61 - e) * 0.30102999566398114 + 347;
+        int k = static_cast<int>(dk);
+        if (dk - k > 0.0)
+            k++;
+        unsigned index = static_cast<unsigned>((k >> 3) + 1);
+        K = -(-348 + static_cast<int>(index << 3));
+        return gsheet_diy_fp_t(f[index], x[index]);
+    }
+
+    void round(char *buf, int len, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t wpw)
+    {
+        while (rest < wpw && delta - rest >= tenKappa && (rest + tenKappa < wpw || wpw - rest > rest + tenKappa - wpw))
+        {
+            buf[len - 1]--;
+            rest += tenKappa;
+        }
+    }
+
+    int countDigits(uint32_t n)
+    {
+        int d = 1;
+        for (uint32_t p = 10; d < 10 && n >= p; p *= 10)
+            d++;
+        return d;
+    }
+
+    void digitGen(const gsheet_diy_fp_t &W, const gsheet_diy_fp_t &Mp, uint64_t delta, char *buf, int &len, int &K)
+    {
+        static const uint32_t pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+        const gsheet_diy_fp_t one(1ULL << -Mp.e, Mp.e);
+        const uint64_t wpw = Mp.f - W.f;
+        uint32_t p1 = static_cast<uint32_t>(Mp.f >> -one.e);
+        uint64_t p2 = Mp.f & (one.f - 1);
+        int kappa = countDigits(p1);
+        len = 0;
+
+        while (kappa > 0)
+        {
+            uint32_t d = p1 / pow10[kappa - 1];
+            p1 %= pow10[kappa - 1];
+            if (d || len)
+                buf[len++] = static_cast<char>('0' + d);
+            kappa--;
+            uint64_t tmp = (static_cast<uint64_t>(p1) << -one.e) + p2;
+            if (tmp <= delta)
+            {
+                K += kappa;
+                round(buf, len, delta, tmp, static_cast<uint64_t>(pow10[kappa]) << -one.e, wpw);
+                return;
+            }
+        }
+
+        while (true)
+        {
+            p2 *= 10;
+            delta *= 10;
+            char d = static_cast<char>(p2 >> -one.e);
+            if (d || len)
+                buf[len++] = static_cast<char>('0' + d);
+            p2 &= one.f - 1;
+            kappa--;
+            if (p2 < delta)
+            {
+                K += kappa;
+                int index = -kappa;
+                round(buf, len, delta, p2, one.f, wpw * (index < 10 ? pow10[index] : 0));
+                return;
+            }
+        }
+    }
+
+    // Generate the shortest digits and decimal exponent of the positive value, value = digits * 10^K.
+    void grisu2(double value, char *buf, int &len, int &K)
+    {
+        uint64_t u;
+        memcpy(&u, &value, sizeof(double));
+        int be = static_cast<int>((u & 0x7FF0000000000000ULL) >> 52);
+        uint64_t sig = u & 0x000FFFFFFFFFFFFFULL;
+        gsheet_diy_fp_t v = be ? gsheet_diy_fp_t(sig + hiddenBit, be - 1075) : gsheet_diy_fp_t(sig, -1074);
+
+        // The boundaries of the values that read back to v.
+        gsheet_diy_fp_t plus((v.f << 1) + 1, v.e - 1);
+        while (!(plus.f & (hiddenBit << 1)))
+        {
+            plus.f <<= 1;
+            plus.e--;
+        }
+        plus.f <<= 10;
+        plus.e -= 10;
+        gsheet_diy_fp_t minus = v.f == hiddenBit ? gsheet_diy_fp_t((v.f << 2) - 1, v.e - 2) : gsheet_diy_fp_t((v.f << 1) - 1, v.e - 1);
+        minus.f <<= minus.e - plus.e;
+        minus.e = plus.e;
+
+        gsheet_diy_fp_t c = cachedPower(plus.e, K);
+        gsheet_diy_fp_t W = mul(normalize(v), c);
+        gsheet_diy_fp_t Wp = mul(plus, c);
+        gsheet_diy_fp_t Wm = mul(minus, c);
+        Wm.f++;
+        Wp.f--;
+        digitGen(W, Wp, Wp.f - Wm.f, buf, len, K);
+    }
+
+public:
+    GSheetNumberFormat() {}
+
+    /**
+     * Write the integer to the buffer, two digits are converted at once.
+     *
+     * @param out The buffer of at least 21 bytes.
+     * @param value The integer.
+     * @return int The number of characters written (without the null terminator).
+     */
+    int formatInt(char *out, int64_t value)
+    {
+        static const char pairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                                    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                                    "8081828384858687888990919293949596979899";
+        char b[20];
+        char *p = b + sizeof(b);
+        uint64_t v = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+        while (v >= 100)
+        {
+            unsigned i = static_cast<unsigned>(v % 100) * 2;
+            v /= 100;
+            *--p = pairs[i + 1];
+            *--p = pairs[i];
+        }
+        if (v >= 10)
+        {
+            *--p = pairs[v * 2 + 1];
+            *--p = pairs[v * 2];
+        }
+        else
+            *--p = static_cast<char>('0' + v);
+
+        int n = 0;
+        if (value < 0)
+            out[n++] = '-';
+        memcpy(out + n, p, b + sizeof(b) - p);
+        n += b + sizeof(b) - p;
+        out[n] = 0;
+        return n;
+    }
+
+    /**
+     * Write the double in the shortest form that reads back to the same value e.g. 0.1, 1.5e-7 or 12345.
+     * The NaN and infinity are written as null.
+     *
+     * @param out The buffer of at least 26 bytes.
+     * @param value The double.
+     * @return int The number of characters written (without the null terminator).
+     */
+    int formatDouble(char *out, double value)
+    {
+        if (isnan(value) || isinf(value))
+        {
+            memcpy(out, "null", 5);
+            return 4;
+        }
+
+        int n = 0;
+        if (value == 0)
+        {
+            out[n++] = '0';
+            out[n] = 0;
+            return n;
+        }
+
+        if (value < 0)
+        {
+            out[n++] = '-';
+            value = -value;
+        }
+
+        char digits[18];
+        int len = 0, K = 0;
+        grisu2(value, digits, len, K);
+        int kk = len + K; // the position of decimal point, 10^(kk-1) <= value < 10^kk
+
+        if (K >= 0 && kk <= 21)
+        {
+            // 1234e7 -> 12340000000
+            memcpy(out + n, digits, len);
+            n += len;
+            for (int i = 0; i < K; i++)
+                out[n++] = '0';
+        }
+        else if (kk > 0 && kk <= 21)
+        {
+            // 1234e-2 -> 12.34
+            memcpy(out + n, digits, kk);
+            n += kk;
+            out[n++] = '.';
+            memcpy(out + n, digits + kk, len - kk);
+            n += len - kk;
+        }
+        else if (kk > -6 && kk <= 0)
+        {
+            // 1234e-6 -> 0.001234
+            out[n++] = '0';
+            out[n++] = '.';
+            for (int i = kk; i < 0; i++)
+                out[n++] = '0';
+            memcpy(out + n, digits, len);
+            n += len;
+        }
+        else
+        {
+            // 1234e30 -> 1.234e33
+            out[n++] = digits[0];
+            if (len > 1)
+            {
+                out[n++] = '.';
+                memcpy(out + n, digits + 1, len - 1);
+                n += len - 1;
+            }
+            out[n++] = 'e';
+            n += formatInt(out + n, kk - 1);
+        }
+        out[n] = 0;
+        return n;
+    }
+};
+
+#endif
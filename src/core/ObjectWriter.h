@@ -38,33 +38,34 @@ private:
     GSheetJSONUtil jut;
 
 public:
+    // The member is inserted in place of the closing token, no temporary copy of buf is made.
     void addMember(String &buf, const String &v, bool isString, const String &token = "}}")
     {
         int p = buf.lastIndexOf(token);
-        String str = buf.substring(0, p);
-        str += ',';
-        // Add to object
+        if (p > -1)
+            buf.remove(p);
+        buf.reserve(buf.length() + v.length() + token.length() + 3);
+        buf += ',';
+        // Add to object, the braces of object (or quotes of string) are removed.
         if (token[0] == '}')
         {
-            String tmp;
             if (isString)
-                tmp += '"';
-            tmp += v;
-            if (isString)
-                tmp += '"';
-            str += tmp.substring(1, tmp.length() - 1);
+                buf += v;
+            else if (v.length() > 1)
+                buf.concat(v.c_str() + 1, v.length() - 2);
+            else
+                buf += v;
         }
         // Add to array
         else
         {
             if (isString)
-                str += '"';
-            str += v;
+                buf += '"';
+            buf += v;
             if (isString)
-                str += '"';
+                buf += '"';
         }
-        str += token;
-        buf = str;
+        buf += token;
     }
 
     void addObject(String &buf, const String &object, const String &token, bool clear = false)
@@ -100,6 +101,10 @@ public:
     void getBuf(String *buf, size_t size)
     {
         clear(buf[0]);
+        size_t len = 0;
+        for (size_t i = 1; i < size; i++)
+            len += buf[i].length();
+        buf[0].reserve(len);
         for (size_t i = 1; i < size; i++)
             addObject(buf[0], buf[i], "}", i == 0);
     }
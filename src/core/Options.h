@@ -195,6 +195,34 @@
 
 #endif
 
+// The RSA implementations for JWT signing
+#define GSHEET_JWT_RSA_DEFAULT 0
+#define GSHEET_JWT_RSA_I15 1
+#define GSHEET_JWT_RSA_I31 2
+#define GSHEET_JWT_RSA_I32 3
+#define GSHEET_JWT_RSA_I62 4
+#define GSHEET_JWT_RSA_AUTO 5
+
+#if !defined(GSHEET_JWT_RSA_BACKEND)
+#define GSHEET_JWT_RSA_BACKEND GSHEET_JWT_RSA_DEFAULT
+#endif
+
+#if defined(GSHEET_ENABLE_JWT_SIGN_TASK)
+#if defined(ESP32)
+#define GSHEET_JWT_SIGN_FREERTOS
+#if !defined(GSHEET_JWT_SIGN_TASK_STACK_SIZE)
+#define GSHEET_JWT_SIGN_TASK_STACK_SIZE 8192
+#endif
+#if !defined(GSHEET_JWT_SIGN_TASK_PRIORITY)
+#define GSHEET_JWT_SIGN_TASK_PRIORITY 1
+#endif
+#elif !defined(ARDUINO) && __has_include(<thread>)
+#define GSHEET_JWT_SIGN_THREAD
+#else
+#undef GSHEET_ENABLE_JWT_SIGN_TASK
+#endif
+#endif
+
 #if !defined(GSHEET_ASYNC_CLIENT)
 #define GSHEET_ASYNC_CLIENT AsyncClient
 #endif
@@ -36,6 +36,16 @@
 #define GSHEET_STRSEP strsep
 #endif
 
+// The value position of JSON member in the source string.
+struct gsheet_json_span_t
+{
+    int start = -1; // the first character of value or -1 if member was not found
+    int end = -1;   // the position after the last character of value
+    bool isString = false;
+    bool found() const { return start > -1; }
+    int length() const { return end - start; }
+};
+
 class GSheetStringUtil
 {
 
@@ -98,6 +108,175 @@ public:
 
     void addSp(String &buf) { buf += ' '; }
 
+    /**
+     * Scan the JSON source once and locate the values of the given member names at any depth.
+     * Only the first occurrence of each name is taken, the string values are located without the quotes
+     * and the object and array values span only their opening bracket.
+     *
+     * @param json The JSON source.
+     * @param len The length of JSON source.
+     * @param names The member names (without quotes).
+     * @param count The number of names.
+     * @param spans The gsheet_json_span_t array (count items) to keep the value positions.
+     * @return The number of names found.
+     */
+    size_t scanJson(const char *json, size_t len, const char *const *names, size_t count, gsheet_json_span_t *spans)
+    {
+        size_t found = 0;
+        size_t i = 0;
+        while (i < len && found < count)
+        {
+            if (json[i] != '"')
+            {
+                i++;
+                continue;
+            }
+
+            size_t s = ++i;
+            i = skipJsonString(json, len, i);
+            size_t e = i++; // closing quote
+
+            size_t p = skipSpace(json, len, i);
+            if (p >= len || json[p] != ':')
+                continue; // string value, not a member name
+
+            int k = -1;
+            for (size_t j = 0; j < count && k < 0; j++)
+            {
+                if (!spans[j].found() && strncmp(json + s, names[j], e - s) == 0 && names[j][e - s] == '\0')
+                    k = j;
+            }
+
+            i = skipSpace(json, len, p + 1);
+            if (k < 0 || i >= len)
+                continue;
+
+            gsheet_json_span_t &span = spans[k];
+            if (json[i] == '"')
+            {
+                span.isString = true;
+                span.start = i + 1;
+                span.end = skipJsonString(json, len, i + 1);
+                i = span.end + 1;
+            }
+            else if (json[i] == '{' || json[i] == '[')
+            {
+                // Keep scanning inside the object or array for the nested members.
+                span.start = i;
+                span.end = i + 1;
+            }
+            else
+            {
+                span.start = i;
+                while (i < len && json[i] != ',' && json[i] != '}' && json[i] != ']' && json[i] != ' ' && json[i] != '\r' && json[i] != '\n')
+                    i++;
+                span.end = i;
+            }
+            found++;
+        }
+        return found;
+    }
+
+    // Copy the JSON value from its position in the source without the intermediate string.
+    void spanStr(const char *json, const gsheet_json_span_t &span, String &dest)
+    {
+        dest.remove(0, dest.length());
+        if (!span.found())
+            return;
+        dest.reserve(span.length());
+        for (int i = span.start; i < span.end; i++)
+            dest += json[i];
+    }
+
+    /**
+     * Locate the next element of JSON array.
+     * The string elements are located without the quotes, the object and array elements span their closing bracket.
+     *
+     * @param json The JSON source.
+     * @param len The length of JSON source.
+     * @param pos The position after the opening bracket of array or the previous element, it is moved past the element.
+     * @param span The gsheet_json_span_t to keep the element position.
+     * @return bool Returns false when the end of array was reached.
+     */
+    bool nextJsonElement(const char *json, size_t len, size_t &pos, gsheet_json_span_t &span)
+    {
+        size_t i = pos;
+        while (i < len && (json[i] == ',' || json[i] == ' ' || json[i] == '\t' || json[i] == '\r' || json[i] == '\n'))
+            i++;
+
+        if (i >= len || json[i] == ']')
+        {
+            pos = i;
+            return false;
+        }
+
+        span.isString = json[i] == '"';
+        if (span.isString)
+        {
+            span.start = i + 1;
+            span.end = skipJsonString(json, len, i + 1);
+            pos = span.end + 1;
+            return true;
+        }
+
+        span.start = i;
+        if (json[i] == '{' || json[i] == '[')
+        {
+            int depth = 0;
+            for (; i < len; i++)
+            {
+                if (json[i] == '"')
+                    i = skipJsonString(json, len, i + 1);
+                else if (json[i] == '{' || json[i] == '[')
+                    depth++;
+                else if ((json[i] == '}' || json[i] == ']') && --depth == 0)
+                    break;
+            }
+            i++;
+        }
+        else
+        {
+            while (i < len && json[i] != ',' && json[i] != ']' && json[i] != ' ' && json[i] != '\r' && json[i] != '\n')
+                i++;
+        }
+        span.end = i < len ? i : len;
+        pos = span.end;
+        return true;
+    }
+
+    // The A1 range key that ignores the absolute reference ($) and letter case of the cell part e.g. Sheet1!$a$1 -> Sheet1!A1.
+    String normalizeA1(const String &range)
+    {
+        String key;
+        key.reserve(range.length());
+        int p = range.lastIndexOf('!');
+        for (int i = 0; i < (int)range.length(); i++)
+        {
+            char c = range[i];
+            if (i <= p)
+                key += c;
+            else if (c != '$')
+                key += (c >= 'a' && c <= 'z') ? (char)(c - 32) : c;
+        }
+        return key;
+    }
+
+    int spanInt(const char *json, const gsheet_json_span_t &span)
+    {
+        int val = 0;
+        bool neg = false;
+        for (int i = span.found() ? span.start : 0; i < span.end; i++)
+        {
+            if (json[i] == '-' && i == span.start)
+                neg = true;
+            else if (json[i] >= '0' && json[i] <= '9')
+                val = val * 10 + (json[i] - '0');
+            else
+                break;
+        }
+        return neg ? -val : val;
+    }
+
     String u64Str(uint64_t val)
     {
         // Some cores do not provide 64-bit integer to string conversion.
@@ -113,6 +292,22 @@ public:
         v = ndx;
         return v;
     }
+
+private:
+    // Returns the position of closing quote or the length of source if not closed.
+    size_t skipJsonString(const char *json, size_t len, size_t i)
+    {
+        while (i < len && json[i] != '"')
+            i += json[i] == '\\' ? 2 : 1;
+        return i < len ? i : len;
+    }
+
+    size_t skipSpace(const char *json, size_t len, size_t i)
+    {
+        while (i < len && (json[i] == ' ' || json[i] == '\t' || json[i] == '\r' || json[i] == '\n'))
+            i++;
+        return i;
+    }
 };
 
 #endif
\ No newline at end of file
@@ -29,7 +29,7 @@
 #include <Client.h>
 #include "./GSheetConfig.h"
 #include "./core/StringUtil.h"
-#include "./core/Memory.h"
+#include "./core/Arena.h"
 
 class GSheetURLUtil
 {
@@ -64,12 +64,10 @@ public:
         if (val.length() == 0)
             return;
 
-        GSheetMemory mem;
-
         GSheetStringUtil sut;
 
-        char *p = reinterpret_cast<char *>(mem.alloc(val.length()));
-        strcpy(p, val.c_str());
+        GSheetScratchArena scratch;
+        char *p = scratch.strdup(val);
         char *pp = p;
         char *end = p;
         String tmp;
@@ -83,8 +81,6 @@ public:
             }
             pp = end;
         }
-        // release memory
-        mem.release(&p);
     }
     /* Append the path to URL */
     void addPath(String &url, const String &path)
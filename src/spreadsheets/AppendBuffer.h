@@ -0,0 +1,415 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2026 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GSHEET_APPEND_BUFFER_H
+#define GSHEET_APPEND_BUFFER_H
+
+#include <Arduino.h>
+#include <math.h>
+#include "./spreadsheets/Values.h"
+
+// The number of rows that triggers the flush.
+#if !defined(GSHEET_APPEND_BUFFER_FLUSH_ROWS)
+#define GSHEET_APPEND_BUFFER_FLUSH_ROWS 50
+#endif
+
+// The number of encoded bytes that triggers the flush.
+#if !defined(GSHEET_APPEND_BUFFER_FLUSH_BYTES)
+#define GSHEET_APPEND_BUFFER_FLUSH_BYTES 2048
+#endif
+
+// The age in milliseconds of the oldest row that triggers the flush, it is also the delay before the failed batch is sent again.
+#if !defined(GSHEET_APPEND_BUFFER_FLUSH_MS)
+#define GSHEET_APPEND_BUFFER_FLUSH_MS 10000
+#endif
+
+// The maximum encoded bytes of the queued rows, the new rows are rejected when the queue is full.
+#if !defined(GSHEET_APPEND_BUFFER_MAX_BYTES)
+#define GSHEET_APPEND_BUFFER_MAX_BYTES 8192
+#endif
+
+// The number of times the failed batch is sent again before its rows are acknowledged with error and dropped.
+#if !defined(GSHEET_APPEND_BUFFER_MAX_RETRY)
+#define GSHEET_APPEND_BUFFER_MAX_RETRY 2
+#endif
+
+/**
+ * The row acknowledgement callback of GSheetAppendBuffer.
+ * @param id The row Id that returned from GSheetAppendBuffer::endRow().
+ * @param aResult The async result of the values.append request that the row was sent with.
+ */
+typedef void (*GSheetRowAckCallback)(uint32_t id, GSheetAsyncResult &aResult);
+
+/**
+ * The write-behind row buffer of the values.append.
+ *
+ * The rows are kept in the compact binary form and sent as one values.append request when the number of rows,
+ * the number of bytes or the age of the oldest row reaches its limit.
+ * The row Ids are acknowledged with the result of request when the batch was committed or finally failed.
+ */
+class GSheetAppendBuffer
+{
+private:
+    enum cell_tag
+    {
+        tag_end,
+        tag_null,
+        tag_false,
+        tag_true,
+        tag_int,
+        tag_double,
+        tag_string
+    };
+
+    Values *values = nullptr;
+    GSheetAsyncClientClass *aClient = nullptr;
+    GSHEET::Parent parent;
+    String range;
+    GSHEET::AppendOptions options;
+    GSheetRowAckCallback cb = NULL;
+    GSheetAsyncResult result;
+
+    // The encoded rows, the rows of batch in flight are at the front.
+    std::vector<uint8_t> data;
+    size_t rowStart = 0, flushBytes = GSHEET_APPEND_BUFFER_FLUSH_BYTES, inflightBytes = 0;
+    uint32_t rows = 0, inflightRows = 0, firstId = 1, flushRows = GSHEET_APPEND_BUFFER_FLUSH_ROWS, flushMs = GSHEET_APPEND_BUFFER_FLUSH_MS, ms = 0;
+    uint8_t retry = 0;
+    bool busy = false;
+
+    void putVarint(uint64_t v)
+    {
+        while (v >= 0x80)
+        {
+            data.push_back((uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        data.push_back((uint8_t)v);
+    }
+
+    uint64_t getVarint(size_t &i) const
+    {
+        uint64_t v = 0;
+        for (uint8_t shift = 0; i < data.size(); shift += 7)
+        {
+            uint8_t b = data[i++];
+            v |= (uint64_t)(b & 0x7f) << shift;
+            if (!(b & 0x80))
+                break;
+        }
+        return v;
+    }
+
+    void putInt(int64_t value)
+    {
+        data.push_back(tag_int);
+        putVarint(((uint64_t)value << 1) ^ (uint64_t)(value >> 63)); // zigzag
+    }
+
+    void putDouble(double value)
+    {
+        data.push_back(tag_double);
+        uint8_t b[sizeof(double)];
+        memcpy(b, &value, sizeof(double));
+        data.insert(data.end(), b, b + sizeof(double));
+    }
+
+    void putString(const char *value, size_t len)
+    {
+        data.push_back(tag_string);
+        putVarint(len);
+        data.insert(data.end(), (const uint8_t *)value, (const uint8_t *)value + len);
+    }
+
+    // Decode the rows in [0, len) of queue to JSON array of rows.
+    void toJson(String &out, size_t len)
+    {
+        GSheetJSONUtil jut;
+        out.reserve(len * 2 + 16);
+        out += '[';
+        bool newRow = true;
+        for (size_t i = 0; i < len;)
+        {
+            uint8_t tag = data[i++];
+            if (tag == tag_end)
+            {
+                out += newRow ? "[]" : "]";
+                newRow = true;
+                if (i < len)
+                    out += ',';
+                continue;
+            }
+
+            out += newRow ? '[' : ',';
+            newRow = false;
+
+            if (tag == tag_null)
+                out += FPSTR("null");
+            else if (tag == tag_false || tag == tag_true)
+                out += tag == tag_true ? FPSTR("true") : FPSTR("false");
+            else if (tag == tag_int)
+            {
+                uint64_t v = getVarint(i);
+                jut.appendInt(out, (int64_t)(v >> 1) ^ -(int64_t)(v & 1));
+            }
+            else if (tag == tag_double)
+            {
+                double v;
+                memcpy(&v, &data[i], sizeof(double));
+                i += sizeof(double);
+                jut.appendDouble(out, v);
+            }
+            else if (tag == tag_string)
+            {
+                size_t n = getVarint(i);
+                jut.appendString(out, (const char *)&data[i], n);
+                i += n;
+            }
+        }
+        out += ']';
+    }
+
+    void send()
+    {
+        String rowsJson;
+        toJson(rowsJson, rowStart);
+        GSHEET::ValueRange valueRange;
+        valueRange.range(range).majorDimension(Dimensions::ROWS).values(gsheet_object_t(rowsJson));
+        rowsJson.remove(0, rowsJson.length());
+
+        inflightBytes = rowStart;
+        inflightRows = rows;
+        busy = true;
+        result.clear();
+        values->append(*aClient, parent, range, valueRange, options, result);
+    }
+
+    // Remove the rows of batch from queue and acknowledge them.
+    void complete()
+    {
+        data.erase(data.begin(), data.begin() + inflightBytes);
+        rowStart -= inflightBytes;
+        rows -= inflightRows;
+        uint32_t id = firstId;
+        firstId += inflightRows;
+        inflightBytes = 0;
+        inflightRows = 0;
+        retry = 0;
+        if (cb)
+        {
+            for (; id < firstId; id++)
+                cb(id, result);
+        }
+    }
+
+    bool flushRequired()
+    {
+        // The failed batch is sent again after the flush interval.
+        if (retry > 0)
+            return millis() - ms >= flushMs;
+        return rows >= flushRows || rowStart >= flushBytes || (rows > 0 && millis() - ms >= flushMs);
+    }
+
+public:
+    GSheetAppendBuffer() {}
+
+    /**
+     * Set the target of the buffer.
+     *
+     * @param values The Values object that used to append the rows.
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param range The A1 notation of a range to search for a logical table of data e.g. Sheet1!A1:F1.
+     * @param cb The GSheetRowAckCallback function that acknowledges each row with the result of request.
+     * @param input How the input data should be interpreted, GSHEET::RAW or GSHEET::USER_ENTERED.
+     */
+    void begin(Values &values, GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const String &range, GSheetRowAckCallback cb = NULL, GSHEET::ValueInputOption input = GSHEET::RAW)
+    {
+        this->values = &values;
+        this->aClient = &aClient;
+        this->parent = parent;
+        this->range = range;
+        this->cb = cb;
+        options = GSHEET::AppendOptions();
+        options.valueInputOption(input).insertDataOption(GSHEET::INSERT_ROWS);
+        ms = millis();
+    }
+
+    /**
+     * Set the flush limits, the rows are sent when any limit is reached.
+     *
+     * @param rows The number of rows.
+     * @param bytes The number of encoded bytes.
+     * @param ms The age in milliseconds of the oldest row.
+     */
+    void setFlushLimits(uint32_t rows, size_t bytes, uint32_t ms)
+    {
+        flushRows = rows;
+        flushBytes = bytes;
+        flushMs = ms;
+    }
+
+    /**
+     * Add the cell value to the current row.
+     */
+    template <typename T>
+    auto add(T value) -> typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, GSheetAppendBuffer &>::type
+    {
+        putInt((int64_t)value);
+        return *this;
+    }
+
+    template <typename T>
+    auto add(T value) -> typename std::enable_if<std::is_floating_point<T>::value, GSheetAppendBuffer &>::type
+    {
+        putDouble(value);
+        return *this;
+    }
+
+    GSheetAppendBuffer &add(bool value)
+    {
+        data.push_back(value ? tag_true : tag_false);
+        return *this;
+    }
+
+    GSheetAppendBuffer &add(const char *value)
+    {
+        putString(value, strlen(value));
+        return *this;
+    }
+
+    GSheetAppendBuffer &add(const String &value)
+    {
+        putString(value.c_str(), value.length());
+        return *this;
+    }
+
+    /**
+     * Add the empty cell to the current row.
+     */
+    GSheetAppendBuffer &addEmpty()
+    {
+        data.push_back(tag_null);
+        return *this;
+    }
+
+    /**
+     * Finish the current row and queue it.
+     *
+     * @return uint32_t The row Id or 0 if the queue is full and the row was discarded.
+     * The caller should keep the data and add the row again later (backpressure).
+     */
+    uint32_t endRow()
+    {
+        if (data.size() + 1 > GSHEET_APPEND_BUFFER_MAX_BYTES)
+        {
+            cancelRow();
+            return 0;
+        }
+        data.push_back(tag_end);
+        rowStart = data.size();
+        // The age of the oldest row that was not sent, the timer of failed batch is kept until it is sent.
+        if (rows == inflightRows && retry == 0)
+            ms = millis();
+        return firstId + rows++;
+    }
+
+    /**
+     * Discard the cells of the current row.
+     */
+    void cancelRow() { data.resize(rowStart); }
+
+    /**
+     * Check whether the row of encoded size can be queued.
+     *
+     * @param bytes The estimated encoded size of the row.
+     * @return bool Returns true if the queue has space for the row.
+     */
+    bool writable(size_t bytes = 32) const { return data.size() + bytes <= GSHEET_APPEND_BUFFER_MAX_BYTES; }
+
+    /**
+     * Send the queued rows now.
+     */
+    void flush()
+    {
+        if (!busy && rows > 0 && values)
+            send();
+    }
+
+    /**
+     * Perform the flush and acknowledge tasks repeatedly.
+     * Should be places in main loop function.
+     */
+    void loop()
+    {
+        if (!values)
+            return;
+
+        if (busy)
+        {
+            if (result.isError())
+            {
+                busy = false;
+                ms = millis();
+                if (retry++ >= GSHEET_APPEND_BUFFER_MAX_RETRY)
+                    complete();
+            }
+            else if (result.available())
+            {
+                busy = false;
+                complete();
+            }
+        }
+        else if (flushRequired())
+            send();
+
+        values->loop();
+    }
+
+    /**
+     * Get the number of queued rows including the rows in flight.
+     * @return uint32_t The number of rows.
+     */
+    uint32_t size() const { return rows; }
+
+    /**
+     * Get the encoded size of queued rows.
+     * @return size_t The number of bytes.
+     */
+    size_t bytes() const { return rowStart; }
+
+    /**
+     * Get the Id of the last acknowledged row.
+     * @return uint32_t The row Id, 0 when no row was acknowledged.
+     */
+    uint32_t acknowledged() const { return firstId - 1; }
+
+    /**
+     * Get the result of the last request.
+     * @return GSheetAsyncResult The reference of async result.
+     */
+    GSheetAsyncResult &lastResult() { return result; }
+};
+
+#endif
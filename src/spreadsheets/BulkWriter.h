@@ -0,0 +1,310 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2026 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GSHEET_BULK_WRITER_H
+#define GSHEET_BULK_WRITER_H
+
+#include <Arduino.h>
+#include "./spreadsheets/Values.h"
+#include "./spreadsheets/ColumnDecoder.h"
+#include "./core/NumberFormat.h"
+
+/**
+ * Write the columns of the caller's arrays as the values of values.update or values.append request.
+ *
+ * The arrays are not copied, they are read when the request payload is built and should be valid until
+ * update or append returns. The row-major matrix is added as the columns with the row stride.
+ * The doubles are written in the shortest form that reads back to the same value and the NaN is written
+ * as null that leaves the cell unchanged.
+ */
+class GSheetBulkWriter
+{
+private:
+    enum column_type
+    {
+        col_double,
+        col_int64,
+        col_bool,
+        col_view,
+        col_cstr
+    };
+
+    struct gsheet_bulk_column_t
+    {
+        column_type type = col_double;
+        const uint8_t *data = nullptr;
+        size_t stride = 0;
+    };
+
+    Values *values = nullptr;
+    GSheetAsyncClientClass *aClient = nullptr;
+    GSHEET::Parent parent;
+    std::vector<gsheet_bulk_column_t> columns;
+    size_t rowCount = 0, cap = 0;
+
+    GSheetBulkWriter &add(column_type type, const void *data, size_t stride)
+    {
+        gsheet_bulk_column_t column;
+        column.type = type;
+        column.data = reinterpret_cast<const uint8_t *>(data);
+        column.stride = stride;
+        columns.push_back(column);
+        return *this;
+    }
+
+    // Append with the capacity grown by half, the String reserves only the requested length.
+    void put(String &out, const char *s, size_t n)
+    {
+        if (out.length() + n > cap)
+        {
+            cap = out.length() + n > cap + cap / 2 ? out.length() + n : cap + cap / 2;
+            out.reserve(cap);
+        }
+        out.concat(s, n);
+    }
+
+    void putString(String &out, char *buf, size_t &n, const char *s, size_t len)
+    {
+        static const char hex[] = "0123456789abcdef";
+        buf[n++] = '"';
+        for (size_t i = 0; i < len; i++)
+        {
+            // Keep room for the escape and the closing quote.
+            if (n > 120)
+            {
+                put(out, buf, n);
+                n = 0;
+            }
+            char c = s[i];
+            if (c == '"' || c == '\\')
+            {
+                buf[n++] = '\\';
+                buf[n++] = c;
+            }
+            else if ((uint8_t)c < 0x20)
+            {
+                memcpy(buf + n, "\\u00", 4);
+                n += 4;
+                buf[n++] = hex[c >> 4];
+                buf[n++] = hex[c & 0xf];
+            }
+            else
+                buf[n++] = c;
+        }
+        buf[n++] = '"';
+    }
+
+    String body(const String &range)
+    {
+        GSheetJSONUtil jut;
+        String out;
+        cap = 64 + range.length() + rowCount * columns.size() * 8;
+        out.reserve(cap);
+        out += FPSTR("{\"range\":");
+        jut.appendString(out, range.c_str(), range.length());
+        out += FPSTR(",\"majorDimension\":\"ROWS\",\"values\":");
+        toJson(out);
+        out += '}';
+        return out;
+    }
+
+    void send(const String &range, const String &query, gsheet_async_request_handler_t::http_request_method method, GSheetAsyncResult *aResult, GSheetAsyncResultCallback cb)
+    {
+        GSheetURLUtil uut;
+        String path = values->spreadsheetPath(parent);
+        path += FPSTR("/values/");
+        path += uut.encode(range);
+        if (method == gsheet_async_request_handler_t::http_post)
+            path += FPSTR(":append");
+        values->sendRequest(*aClient, aResult, cb, "", path, query, method, body(range));
+    }
+
+public:
+    GSheetBulkWriter() {}
+
+    /**
+     * Set the Values object and async client that used to send the requests.
+     *
+     * @param values The Values object.
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     */
+    void begin(Values &values, GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent)
+    {
+        this->values = &values;
+        this->aClient = &aClient;
+        this->parent = parent;
+    }
+
+    /**
+     * Set the number of rows to write.
+     * @param rows The number of rows, every column array should have at least this number of items.
+     */
+    GSheetBulkWriter &setRows(size_t rows)
+    {
+        rowCount = rows;
+        return *this;
+    }
+
+    /**
+     * Add the column array, the columns are written in order.
+     *
+     * @param data The first item of column.
+     * @param stride The bytes between the items e.g. the row size of row-major matrix.
+     */
+    GSheetBulkWriter &addColumn(const double *data, size_t stride = sizeof(double)) { return add(col_double, data, stride); }
+    GSheetBulkWriter &addColumn(const int64_t *data, size_t stride = sizeof(int64_t)) { return add(col_int64, data, stride); }
+    GSheetBulkWriter &addColumn(const bool *data, size_t stride = sizeof(bool)) { return add(col_bool, data, stride); }
+    GSheetBulkWriter &addColumn(const gsheet_string_view_t *data, size_t stride = sizeof(gsheet_string_view_t)) { return add(col_view, data, stride); }
+    GSheetBulkWriter &addColumn(const char *const *data, size_t stride = sizeof(const char *)) { return add(col_cstr, data, stride); }
+
+    /**
+     * Add the columns of the row-major matrix.
+     *
+     * @param data The first item of matrix.
+     * @param cols The number of columns of matrix.
+     */
+    template <typename T>
+    GSheetBulkWriter &addRowMajor(const T *data, size_t cols)
+    {
+        for (size_t c = 0; c < cols; c++)
+            addColumn(data + c, cols * sizeof(T));
+        return *this;
+    }
+
+    /**
+     * Remove the columns and rows.
+     */
+    void clear()
+    {
+        columns.clear();
+        rowCount = 0;
+    }
+
+    /**
+     * Write the JSON array of rows e.g. [[1,"a"],[2.5,"b"]].
+     * @param out The String to append the array.
+     */
+    void toJson(String &out)
+    {
+        GSheetNumberFormat nf;
+        char buf[160];
+        size_t n = 0;
+        if (cap < out.length())
+            cap = out.length();
+        buf[n++] = '[';
+        for (size_t r = 0; r < rowCount; r++)
+        {
+            // Flush before the row or item that may not fit, the rows without columns are written as [].
+            if (n > 120)
+            {
+                put(out, buf, n);
+                n = 0;
+            }
+            if (r > 0)
+                buf[n++] = ',';
+            buf[n++] = '[';
+            for (size_t c = 0; c < columns.size(); c++)
+            {
+                if (n > 120)
+                {
+                    put(out, buf, n);
+                    n = 0;
+                }
+                if (c > 0)
+                    buf[n++] = ',';
+                const gsheet_bulk_column_t &column = columns[c];
+                const uint8_t *item = column.data + r * column.stride;
+                if (column.type == col_double)
+                {
+                    double v;
+                    memcpy(&v, item, sizeof(double));
+                    n += nf.formatDouble(buf + n, v);
+                }
+                else if (column.type == col_int64)
+                {
+                    int64_t v;
+                    memcpy(&v, item, sizeof(int64_t));
+                    n += nf.formatInt(buf + n, v);
+                }
+                else if (column.type == col_bool)
+                {
+                    bool v = *reinterpret_cast<const bool *>(item);
+                    memcpy(buf + n, v ? "true" : "false", v ? 4 : 5);
+                    n += v ? 4 : 5;
+                }
+                else if (column.type == col_view)
+                {
+                    gsheet_string_view_t v;
+                    memcpy(&v, item, sizeof(v));
+                    putString(out, buf, n, v.data ? v.data : "", v.data ? v.len : 0);
+                }
+                else
+                {
+                    const char *v;
+                    memcpy(&v, item, sizeof(v));
+                    putString(out, buf, n, v ? v : "", v ? strlen(v) : 0);
+                }
+            }
+            buf[n++] = ']';
+        }
+        buf[n++] = ']';
+        put(out, buf, n);
+    }
+
+    /** Sets the rows in a range of a spreadsheet.
+     *
+     * @param range The A1 notation of the values to update.
+     * @param options The GSHEET::UpdateOptions object, the valueInputOption is required.
+     * @param aResult The async result (GSheetAsyncResult).
+     */
+    void update(const String &range, const GSHEET::UpdateOptions &options, GSheetAsyncResult &aResult) { send(range, options.getQueryString(), gsheet_async_request_handler_t::http_put, &aResult, NULL); }
+
+    /** Sets the rows in a range of a spreadsheet.
+     *
+     * @param range The A1 notation of the values to update.
+     * @param options The GSHEET::UpdateOptions object, the valueInputOption is required.
+     * @param cb The async result callback (GSheetAsyncResultCallback).
+     */
+    void update(const String &range, const GSHEET::UpdateOptions &options, GSheetAsyncResultCallback cb) { send(range, options.getQueryString(), gsheet_async_request_handler_t::http_put, nullptr, cb); }
+
+    /** Appends the rows to the table of a spreadsheet.
+     *
+     * @param range The A1 notation of a range to search for a logical table of data.
+     * @param options The GSHEET::AppendOptions object, the valueInputOption is required.
+     * @param aResult The async result (GSheetAsyncResult).
+     */
+    void append(const String &range, const GSHEET::AppendOptions &options, GSheetAsyncResult &aResult) { send(range, options.getQueryString(), gsheet_async_request_handler_t::http_post, &aResult, NULL); }
+
+    /** Appends the rows to the table of a spreadsheet.
+     *
+     * @param range The A1 notation of a range to search for a logical table of data.
+     * @param options The GSHEET::AppendOptions object, the valueInputOption is required.
+     * @param cb The async result callback (GSheetAsyncResultCallback).
+     */
+    void append(const String &range, const GSHEET::AppendOptions &options, GSheetAsyncResultCallback cb) { send(range, options.getQueryString(), gsheet_async_request_handler_t::http_post, nullptr, cb); }
+};
+
+#endif
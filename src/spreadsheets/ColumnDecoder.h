@@ -0,0 +1,479 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2026 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GSHEET_COLUMN_DECODER_H
+#define GSHEET_COLUMN_DECODER_H
+
+#include <Arduino.h>
+#include "./core/Arena.h"
+#include "./core/StringUtil.h"
+#include "./core/AsyncResult/AsyncResult.h"
+
+enum gsheet_column_type
+{
+    gsheet_column_double,
+    gsheet_column_int64,
+    gsheet_column_bool,
+    gsheet_column_string
+};
+
+// The string in the decoder arena, it is valid until the next decode or clear.
+struct gsheet_string_view_t
+{
+    const char *data = nullptr;
+    uint32_t len = 0;
+};
+
+/**
+ * Decode the values of ValueRange (values.get or the first range of values:batchGet response with
+ * majorDimension=ROWS and valueRenderOption=UNFORMATTED_VALUE) into typed column arrays.
+ *
+ * The payload is scanned twice, the first pass counts the rows and string bytes so that each column array
+ * and the string pool are allocated once from the arena, the second pass converts the cells.
+ * The cells that are missing or can not be converted are null, the double cells are NaN and the others are zero or empty.
+ */
+class GSheetColumnDecoder
+{
+private:
+    struct gsheet_column_t
+    {
+        gsheet_column_type type = gsheet_column_string;
+        void *data = nullptr;
+        uint8_t *valid = nullptr;
+    };
+
+    std::vector<gsheet_column_t> columns;
+    GSheetArena arena;
+    GSheetValueConverter vcon;
+    size_t rowCount = 0, declared = 0;
+    char *pool = nullptr;
+    size_t poolUsed = 0;
+
+    static bool hasByte(uint32_t v, uint32_t pattern)
+    {
+        uint32_t x = v ^ pattern;
+        return ((x - 0x01010101UL) & ~x & 0x80808080UL) != 0;
+    }
+
+    // Find the closing quote of string, four bytes are checked at once for quote and backslash.
+    const char *skipString(const char *p, const char *end)
+    {
+        while (p < end)
+        {
+            uint32_t w;
+            while (end - p >= 4)
+            {
+                memcpy(&w, p, 4);
+                if (hasByte(w, 0x22222222UL) || hasByte(w, 0x5c5c5c5cUL))
+                    break;
+                p += 4;
+            }
+            while (p < end && *p != '"' && *p != '\\')
+                p++;
+            if (p >= end || *p == '"')
+                return p;
+            p = p + 2 < end ? p + 2 : end;
+        }
+        return end;
+    }
+
+    static bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+    // Locate the next value of array, the string value includes its quotes.
+    bool nextValue(const char *&p, const char *end, const char *&vs, const char *&ve)
+    {
+        while (p < end && (*p == ',' || isSpace(*p)))
+            p++;
+        if (p >= end || *p == ']')
+        {
+            if (p < end)
+                p++;
+            return false;
+        }
+
+        vs = p;
+        if (*p == '"')
+            p = skipString(p + 1, end) + 1;
+        else if (*p == '[' || *p == '{')
+        {
+            int depth = 0;
+            for (; p < end; p++)
+            {
+                if (*p == '"')
+                    p = skipString(p + 1, end);
+                else if (*p == '[' || *p == '{')
+                    depth++;
+                else if ((*p == ']' || *p == '}') && --depth == 0)
+                    break;
+            }
+            p++;
+        }
+        else
+        {
+            while (p < end && *p != ',' && *p != ']' && *p != '}' && !isSpace(*p))
+                p++;
+        }
+        if (p > end)
+            p = end;
+        ve = p;
+        return true;
+    }
+
+    void putUtf8(char *&out, uint32_t cp)
+    {
+        if (cp < 0x80)
+            *out++ = cp;
+        else if (cp < 0x800)
+        {
+            *out++ = 0xc0 | (cp >> 6);
+            *out++ = 0x80 | (cp & 0x3f);
+        }
+        else if (cp < 0x10000)
+        {
+            *out++ = 0xe0 | (cp >> 12);
+            *out++ = 0x80 | ((cp >> 6) & 0x3f);
+            *out++ = 0x80 | (cp & 0x3f);
+        }
+        else
+        {
+            *out++ = 0xf0 | (cp >> 18);
+            *out++ = 0x80 | ((cp >> 12) & 0x3f);
+            *out++ = 0x80 | ((cp >> 6) & 0x3f);
+            *out++ = 0x80 | (cp & 0x3f);
+        }
+    }
+
+    uint32_t hex4(const char *p, const char *end)
+    {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            char c = p + i < end ? p[i] : 0;
+            v = v * 16 + (c >= '0' && c <= '9' ? c - '0' : (c | 0x20) >= 'a' && (c | 0x20) <= 'f' ? (c | 0x20) - 'a' + 10
+                                                                                                      : 0);
+        }
+        return v;
+    }
+
+    // Copy the string value to the pool with the escapes decoded, the unescaped string is never longer than the source.
+    gsheet_string_view_t toView(const char *vs, const char *ve)
+    {
+        gsheet_string_view_t view;
+        bool quoted = *vs == '"';
+        const char *p = quoted ? vs + 1 : vs, *end = quoted && ve > p ? ve - 1 : ve;
+        char *out = pool + poolUsed;
+        view.data = out;
+        while (p < end)
+        {
+            const char *q = quoted ? reinterpret_cast<const char *>(memchr(p, '\\', end - p)) : nullptr;
+            if (!q)
+                q = end;
+            memcpy(out, p, q - p);
+            out += q - p;
+            p = q;
+            if (p >= end)
+                break;
+            // The escape sequence.
+            char c = p + 1 < end ? p[1] : 0;
+            p += 2;
+            if (c == 'u')
+            {
+                uint32_t cp = hex4(p, end);
+                p += 4;
+                if (cp >= 0xd800 && cp < 0xdc00 && p + 6 <= end && p[0] == '\\' && p[1] == 'u')
+                {
+                    uint32_t lo = hex4(p + 2, end);
+                    if (lo >= 0xdc00 && lo < 0xe000)
+                    {
+                        cp = 0x10000 + ((cp - 0xd800) << 10) + (lo - 0xdc00);
+                        p += 6;
+                    }
+                }
+                putUtf8(out, cp);
+            }
+            else
+                *out++ = c == 'n' ? '\n' : c == 't' ? '\t'
+                                       : c == 'r'   ? '\r'
+                                       : c == 'b'   ? '\b'
+                                       : c == 'f'   ? '\f'
+                                                    : c;
+        }
+        *out++ = 0;
+        view.len = out - view.data - 1;
+        poolUsed = out - pool;
+        return view;
+    }
+
+    // The TRUE or FALSE string in any case.
+    bool boolStr(const char *s, const char *e, bool &b)
+    {
+        const char *word = e - s == 4 ? "true" : e - s == 5 ? "false"
+                                                             : nullptr;
+        for (const char *w = word; w && *w; w++, s++)
+        {
+            if ((*s | 0x20) != *w)
+                return false;
+        }
+        b = word && word[0] == 't';
+        return word != nullptr;
+    }
+
+    void setCell(gsheet_column_t &column, size_t row, const char *vs, const char *ve)
+    {
+        double d = 0;
+        int64_t i = 0;
+        bool integral = false, b = false;
+        bool isStr = *vs == '"';
+        const char *s = isStr ? vs + 1 : vs, *e = isStr && ve > s ? ve - 1 : ve;
+
+        if (*vs == 'n')
+            return;
+
+        if (column.type == gsheet_column_string)
+            reinterpret_cast<gsheet_string_view_t *>(column.data)[row] = toView(vs, ve);
+        else
+        {
+            if (*vs == 't' || *vs == 'f' || (isStr && boolStr(s, e, b)))
+            {
+                b = isStr ? b : *vs == 't';
+                d = i = b;
+            }
+            else if (s < e && vcon.parseNumber(s, e, d, i, integral) == e)
+                b = d != 0;
+            else
+                return;
+
+            if (column.type == gsheet_column_double)
+                reinterpret_cast<double *>(column.data)[row] = d;
+            else if (column.type == gsheet_column_int64)
+                reinterpret_cast<int64_t *>(column.data)[row] = i;
+            else
+                reinterpret_cast<bool *>(column.data)[row] = b;
+        }
+        column.valid[row >> 3] |= 1 << (row & 7);
+    }
+
+    // Walk the values array, count the rows and string bytes or convert the cells.
+    void walk(const char *p, const char *end, bool fill, size_t &rows, size_t &width, size_t &bytes)
+    {
+        const char *vs, *ve;
+        size_t row = 0;
+        while (true)
+        {
+            while (p < end && (*p == ',' || isSpace(*p)))
+                p++;
+            if (p >= end || *p == ']')
+                break;
+            if (*p != '[')
+            {
+                // Not a row array.
+                nextValue(p, end, vs, ve);
+                continue;
+            }
+
+            p++;
+            size_t col = 0;
+            while (nextValue(p, end, vs, ve))
+            {
+                if (!fill)
+                {
+                    if (declared == 0 || (col < declared && columns[col].type == gsheet_column_string))
+                        bytes += ve - vs + 1;
+                }
+                else if (col < columns.size())
+                    setCell(columns[col], row, vs, ve);
+                col++;
+            }
+            if (col > width)
+                width = col;
+            row++;
+        }
+        rows = row;
+    }
+
+    void *allocArray(size_t len)
+    {
+        // The arena is 4 bytes aligned, the double and int64_t arrays are aligned to 8 bytes.
+        uint8_t *p = reinterpret_cast<uint8_t *>(arena.alloc(len + 4));
+        return p ? reinterpret_cast<void *>(((uintptr_t)p + 7) & ~(uintptr_t)7) : nullptr;
+    }
+
+public:
+    GSheetColumnDecoder() {}
+
+    /**
+     * Add the column type, the columns are added in order from the first column of range.
+     * The undeclared columns are decoded as string when no column was added.
+     *
+     * @param type The gsheet_column_type e.g. gsheet_column_double.
+     */
+    GSheetColumnDecoder &addColumn(gsheet_column_type type)
+    {
+        gsheet_column_t column;
+        column.type = type;
+        columns.resize(declared);
+        columns.push_back(column);
+        declared = columns.size();
+        rowCount = 0;
+        return *this;
+    }
+
+    /**
+     * Decode the values of ValueRange.
+     *
+     * @param json The JSON payload of values.get or values:batchGet.
+     * @param len The length of payload.
+     * @return bool The values array was found and the memory was allocated.
+     */
+    bool decode(const char *json, size_t len)
+    {
+        GSheetStringUtil sut;
+        const char *names[] = {"values"};
+        gsheet_json_span_t arr;
+        clearData();
+        if (!json || !sut.scanJson(json, len, names, 1, &arr) || json[arr.start] != '[')
+            return false;
+
+        const char *p = json + arr.start + 1, *end = json + len;
+        size_t rows = 0, width = 0, bytes = 0;
+        walk(p, end, false, rows, width, bytes);
+
+        if (declared == 0)
+            columns.resize(width);
+        pool = bytes ? reinterpret_cast<char *>(arena.alloc(bytes, false)) : nullptr;
+        if (bytes && !pool)
+            return false;
+
+        static const size_t size[] = {sizeof(double), sizeof(int64_t), sizeof(bool), sizeof(gsheet_string_view_t)};
+        for (size_t c = 0; c < columns.size(); c++)
+        {
+            gsheet_column_t &column = columns[c];
+            column.data = allocArray(rows * size[column.type]);
+            column.valid = reinterpret_cast<uint8_t *>(arena.alloc((rows + 7) / 8));
+            if (!column.data || !column.valid)
+                return false;
+            if (column.type == gsheet_column_double)
+            {
+                for (size_t r = 0; r < rows; r++)
+                    reinterpret_cast<double *>(column.data)[r] = NAN;
+            }
+            else
+                memset(column.data, 0, rows * size[column.type]);
+            if (column.type == gsheet_column_string)
+            {
+                for (size_t r = 0; r < rows; r++)
+                    reinterpret_cast<gsheet_string_view_t *>(column.data)[r].data = "";
+            }
+        }
+
+        rowCount = rows;
+        walk(p, end, true, rows, width, bytes);
+        return true;
+    }
+
+    /**
+     * Decode the values of ValueRange from the async result.
+     *
+     * @param aResult The async result of values.get or values:batchGet.
+     * @return bool The values array was found and the memory was allocated.
+     */
+    bool decode(GSheetAsyncResult &aResult) { return decode(aResult.c_str(), strlen(aResult.c_str())); }
+
+    /**
+     * Release the decoded data, the column types are kept.
+     */
+    void clearData()
+    {
+        for (size_t c = 0; c < columns.size(); c++)
+        {
+            columns[c].data = nullptr;
+            columns[c].valid = nullptr;
+        }
+        columns.resize(declared);
+        arena.reset();
+        pool = nullptr;
+        poolUsed = 0;
+        rowCount = 0;
+    }
+
+    /**
+     * Remove the column types and the decoded data.
+     */
+    void clear()
+    {
+        declared = 0;
+        clearData();
+    }
+
+    /**
+     * Get the number of decoded rows.
+     * @return size_t The number of rows.
+     */
+    size_t rows() const { return rowCount; }
+
+    /**
+     * Get the number of columns.
+     * @return size_t The number of columns.
+     */
+    size_t cols() const { return columns.size(); }
+
+    /**
+     * Get the double array of the column.
+     * @param col The zero-based column.
+     * @return const double * The array of rows() items or nullptr if the column is not gsheet_column_double.
+     */
+    const double *doubles(size_t col) const { return col < columns.size() && columns[col].type == gsheet_column_double ? reinterpret_cast<const double *>(columns[col].data) : nullptr; }
+
+    /**
+     * Get the int64_t array of the column.
+     * @param col The zero-based column.
+     * @return const int64_t * The array of rows() items or nullptr if the column is not gsheet_column_int64.
+     */
+    const int64_t *integers(size_t col) const { return col < columns.size() && columns[col].type == gsheet_column_int64 ? reinterpret_cast<const int64_t *>(columns[col].data) : nullptr; }
+
+    /**
+     * Get the bool array of the column.
+     * @param col The zero-based column.
+     * @return const bool * The array of rows() items or nullptr if the column is not gsheet_column_bool.
+     */
+    const bool *booleans(size_t col) const { return col < columns.size() && columns[col].type == gsheet_column_bool ? reinterpret_cast<const bool *>(columns[col].data) : nullptr; }
+
+    /**
+     * Get the string view array of the column.
+     * @param col The zero-based column.
+     * @return const gsheet_string_view_t * The array of rows() items or nullptr if the column is not gsheet_column_string.
+     */
+    const gsheet_string_view_t *strings(size_t col) const { return col < columns.size() && columns[col].type == gsheet_column_string ? reinterpret_cast<const gsheet_string_view_t *>(columns[col].data) : nullptr; }
+
+    /**
+     * Check whether the cell is missing or could not be converted.
+     * @param row The zero-based row.
+     * @param col The zero-based column.
+     * @return bool The cell is null.
+     */
+    bool isNull(size_t row, size_t col) const { return row >= rowCount || col >= columns.size() || !(columns[col].valid[row >> 3] & (1 << (row & 7))); }
+};
+
+#endif
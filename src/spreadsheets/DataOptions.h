@@ -28,11 +28,15 @@
 #include <Arduino.h>
 #include "./Config.h"
 #include "./core/JSON.h"
+#include "./core/URL.h"
 #include "./core/ObjectWriter.h"
 #include "./spreadsheets/requests/Requests.h"
+#include "./spreadsheets/requests/FieldMask.h"
 
 #define GSHEET_RESOURCE_PATH_BASE FPSTR("<resource_path>")
 
+class GSheetRangeCache;
+
 enum gsheet_request_type
 {
     gsheet_request_type_undefined,
@@ -98,13 +102,16 @@ namespace GSHEET
     public:
         GetOptions() {}
 
+        // This value represents the item to add to an array.
         // The ranges to retrieve from the spreadsheet.
-        // Ranges separated with comma ",".
         GetOptions &ranges(const String &value)
         {
-            qr[0] = FPSTR(__func__);
+            GSheetURLUtil uut;
+            if (qr[0].length())
+                qr[0] += "&";
+            qr[0] += FPSTR(__func__);
             qr[0] += "=";
-            qr[0] = value;
+            qr[0] += uut.encode(value);
             return *this;
         }
 
@@ -133,6 +140,9 @@ namespace GSHEET
             return *this;
         }
 
+        // The desired fields from the GSHEET::SpreadsheetFields builder.
+        GetOptions &fields(const SpreadsheetFields &value) { return fields(String(value.c_str())); }
+
         String getQueryString()
         {
             String str;
@@ -198,19 +208,41 @@ namespace GSHEET
 
     class BatchGetOptions
     {
+        friend class ::GSheetRangeCache;
+
     private:
         static const size_t bufSize = 4;
         String qr[bufSize];
+        std::vector<String> rangeList;
 
     public:
         BatchGetOptions() {}
 
+        // This value represents the item to add to an array.
         // The A1 notation or R1C1 notation of the range to retrieve values from.
+        // Ranges separated with comma "," (outside the quoted sheet name).
         BatchGetOptions &ranges(const String &value)
         {
-            qr[0] = FPSTR(__func__);
-            qr[0] += "=";
-            qr[0] += value;
+            GSheetURLUtil uut;
+            bool quoted = false;
+            int p1 = 0;
+            for (int i = 0; i <= (int)value.length(); i++)
+            {
+                if (i < (int)value.length() && value[i] == '\'')
+                    quoted = !quoted;
+                if (i < (int)value.length() && (quoted || value[i] != ','))
+                    continue;
+                if (i > p1)
+                {
+                    rangeList.push_back(value.substring(p1, i));
+                    if (qr[0].length())
+                        qr[0] += "&";
+                    qr[0] += FPSTR(__func__);
+                    qr[0] += "=";
+                    qr[0] += uut.encode(rangeList.back());
+                }
+                p1 = i + 1;
+            }
             return *this;
         }
 
@@ -244,10 +276,11 @@ namespace GSHEET
             return *this;
         }
 
-        String getQueryString()
+        String getQueryString() const
         {
-            String str;
-            for (size_t i = 0; i < bufSize; i++)
+            // Each range was kept as repeated (URL encoded) ranges parameter.
+            String str = qr[0];
+            for (size_t i = 1; i < bufSize; i++)
             {
                 if (qr[i].length())
                 {
@@ -281,6 +314,178 @@ namespace GSHEET
         BatchGetByDataFilterOpions &dateTimeRenderOption(DateTimeRenderOption value) { return wr.set<BatchGetByDataFilterOpions &, const char *>(*this, _DateTimeRenderOption[value].text, buf, bufSize, 4, FPSTR(__func__)); }
     };
 
+    // https://developers.google.com/sheets/api/reference/rest/v4/spreadsheets.values#ValueRange
+
+    /**
+     * Data within a range of the spreadsheet.
+     */
+    class ValueRange : public BaseG4
+    {
+    public:
+        ValueRange() {}
+
+        // The range the values cover, in A1 notation.
+        ValueRange &range(const String &value) { return wr.set<ValueRange &, String>(*this, value, buf, bufSize, 1, FPSTR(__func__)); }
+
+        // The major dimension of the values.
+        ValueRange &majorDimension(Dimensions::Dimension value) { return wr.set<ValueRange &, const char *>(*this, _Dimension[value].text, buf, bufSize, 2, FPSTR(__func__)); }
+
+        // The data that was read or to be written. This is an array of arrays, the outer array representing all the data and each inner array representing a major dimension e.g. [[1,"a"],[2,"b"]].
+        ValueRange &values(const gsheet_object_t &value) { return wr.set<ValueRange &, gsheet_object_t>(*this, value, buf, bufSize, 3, FPSTR(__func__)); }
+    };
+
+    class AppendOptions
+    {
+    private:
+        static const size_t bufSize = 5;
+        String qr[bufSize];
+
+        void setQuery(uint8_t index, const String &name, const String &value)
+        {
+            qr[index] = name;
+            qr[index] += "=";
+            qr[index] += value;
+        }
+
+    public:
+        AppendOptions() {}
+
+        // How the input data should be interpreted.
+        AppendOptions &valueInputOption(ValueInputOption value)
+        {
+            setQuery(0, FPSTR(__func__), _ValueInputOption[value].text);
+            return *this;
+        }
+
+        // How the input data should be inserted.
+        AppendOptions &insertDataOption(InsertDataOption value)
+        {
+            setQuery(1, FPSTR(__func__), _InsertDataOption[value].text);
+            return *this;
+        }
+
+        // Determines if the update response should include the values of the cells that were appended. By default, responses do not include the updated values.
+        AppendOptions &includeValuesInResponse(bool value)
+        {
+            setQuery(2, FPSTR(__func__), value ? "true" : "false");
+            return *this;
+        }
+
+        // Determines how values in the response should be rendered. The default render option is FORMATTED_VALUE.
+        AppendOptions &responseValueRenderOption(ValueRenderOption value)
+        {
+            setQuery(3, FPSTR(__func__), _ValueRenderOption[value].text);
+            return *this;
+        }
+
+        // Determines how dates, times, and durations in the response should be rendered. This is ignored if responseValueRenderOption is FORMATTED_VALUE. The default dateTime render option is SERIAL_NUMBER.
+        AppendOptions &responseDateTimeRenderOption(DateTimeRenderOption value)
+        {
+            setQuery(4, FPSTR(__func__), _DateTimeRenderOption[value].text);
+            return *this;
+        }
+
+        String getQueryString() const
+        {
+            String str;
+            for (size_t i = 0; i < bufSize; i++)
+            {
+                if (qr[i].length())
+                {
+                    if (str.length())
+                        str += "&";
+                    str += qr[i];
+                }
+            }
+            return str;
+        }
+    };
+
+    class UpdateOptions
+    {
+    private:
+        static const size_t bufSize = 4;
+        String qr[bufSize];
+
+        void setQuery(uint8_t index, const String &name, const String &value)
+        {
+            qr[index] = name;
+            qr[index] += "=";
+            qr[index] += value;
+        }
+
+    public:
+        UpdateOptions() {}
+
+        // How the input data should be interpreted.
+        UpdateOptions &valueInputOption(ValueInputOption value)
+        {
+            setQuery(0, FPSTR(__func__), _ValueInputOption[value].text);
+            return *this;
+        }
+
+        // Determines if the update response should include the values of the cells that were updated. By default, responses do not include the updated values.
+        UpdateOptions &includeValuesInResponse(bool value)
+        {
+            setQuery(1, FPSTR(__func__), value ? "true" : "false");
+            return *this;
+        }
+
+        // Determines how values in the response should be rendered. The default render option is FORMATTED_VALUE.
+        UpdateOptions &responseValueRenderOption(ValueRenderOption value)
+        {
+            setQuery(2, FPSTR(__func__), _ValueRenderOption[value].text);
+            return *this;
+        }
+
+        // Determines how dates, times, and durations in the response should be rendered. This is ignored if responseValueRenderOption is FORMATTED_VALUE. The default dateTime render option is SERIAL_NUMBER.
+        UpdateOptions &responseDateTimeRenderOption(DateTimeRenderOption value)
+        {
+            setQuery(3, FPSTR(__func__), _DateTimeRenderOption[value].text);
+            return *this;
+        }
+
+        String getQueryString() const
+        {
+            String str;
+            for (size_t i = 0; i < bufSize; i++)
+            {
+                if (qr[i].length())
+                {
+                    if (str.length())
+                        str += "&";
+                    str += qr[i];
+                }
+            }
+            return str;
+        }
+    };
+
+    /**
+     * Values batch update options
+     */
+    class BatchUpdateValuesOptions : public BaseG6
+    {
+    public:
+        BatchUpdateValuesOptions() {}
+
+        // How the input data should be interpreted.
+        BatchUpdateValuesOptions &valueInputOption(ValueInputOption value) { return wr.set<BatchUpdateValuesOptions &, const char *>(*this, _ValueInputOption[value].text, buf, bufSize, 1, FPSTR(__func__)); }
+
+        // This value represents the item to add to an array.
+        // The new values to apply to the spreadsheet.
+        BatchUpdateValuesOptions &data(const ValueRange &value) { return wr.append<BatchUpdateValuesOptions &, ValueRange>(*this, value, buf, bufSize, 2, FPSTR(__func__)); }
+
+        // Determines if the update response should include the values of the cells that were updated. By default, responses do not include the updated values.
+        BatchUpdateValuesOptions &includeValuesInResponse(bool value) { return wr.set<BatchUpdateValuesOptions &, bool>(*this, value, buf, bufSize, 3, FPSTR(__func__)); }
+
+        // Determines how values in the response should be rendered. The default render option is FORMATTED_VALUE.
+        BatchUpdateValuesOptions &responseValueRenderOption(ValueRenderOption value) { return wr.set<BatchUpdateValuesOptions &, const char *>(*this, _ValueRenderOption[value].text, buf, bufSize, 4, FPSTR(__func__)); }
+
+        // Determines how dates, times, and durations in the response should be rendered. This is ignored if responseValueRenderOption is FORMATTED_VALUE. The default dateTime render option is SERIAL_NUMBER.
+        BatchUpdateValuesOptions &responseDateTimeRenderOption(DateTimeRenderOption value) { return wr.set<BatchUpdateValuesOptions &, const char *>(*this, _DateTimeRenderOption[value].text, buf, bufSize, 5, FPSTR(__func__)); }
+    };
+
     class Parent
     {
         friend class GSheetBase;
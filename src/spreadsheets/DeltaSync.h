@@ -0,0 +1,587 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2026 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GSHEET_DELTA_SYNC_H
+#define GSHEET_DELTA_SYNC_H
+
+#include <Arduino.h>
+#include "./spreadsheets/Values.h"
+#include "./core/AsyncResult/ResultFanout.h"
+
+// The number of rows of the hashed block.
+#if !defined(GSHEET_DELTA_SYNC_BLOCK_ROWS)
+#define GSHEET_DELTA_SYNC_BLOCK_ROWS 8
+#endif
+
+// The number of columns of the hashed block, 0 for all columns of the range.
+#if !defined(GSHEET_DELTA_SYNC_BLOCK_COLS)
+#define GSHEET_DELTA_SYNC_BLOCK_COLS 0
+#endif
+
+// The interval in milliseconds that the changed blocks are sent from loop, 0 to send only when sync is called.
+#if !defined(GSHEET_DELTA_SYNC_INTERVAL_MS)
+#define GSHEET_DELTA_SYNC_INTERVAL_MS 60000
+#endif
+
+/**
+ * Mirror the A1 range e.g. Sheet1!A1:F50 locally and send only the changed blocks.
+ *
+ * The local cells are hashed in blocks of rows (and columns) and compared with the hashes of the last
+ * committed state, the changed blocks are sent as the ranges of one values:batchUpdate request.
+ * The block is committed when the request was successful, the failed blocks are sent again in the next sync.
+ */
+class GSheetDeltaSync
+{
+private:
+    enum sync_state
+    {
+        sync_idle,
+        sync_pull,
+        sync_push
+    };
+
+    struct gsheet_sync_block_t
+    {
+        uint32_t index = 0, hash = 0;
+    };
+
+    Values *values = nullptr;
+    GSheetAsyncClientClass *aClient = nullptr;
+    GSHEET::Parent parent;
+    GSHEET::ValueInputOption input = GSHEET::RAW;
+    String sheet;
+    uint32_t firstCol = 1, firstRow = 1, rows = 0, cols = 0;
+    uint32_t blockRows = GSHEET_DELTA_SYNC_BLOCK_ROWS, blockCols = GSHEET_DELTA_SYNC_BLOCK_COLS, tileRows = 0, tileCols = 0;
+    // The cells in JSON value, the empty cell is sent as empty string to clear the sheet cell.
+    std::vector<String> cells;
+    std::vector<uint32_t> current, committed;
+    std::vector<uint8_t> dirty;
+    std::vector<gsheet_sync_block_t> inflight;
+    gsheet_result_owner_t owner;
+    GSheetResultFanout fanout;
+    GSheetAsyncResult result;
+    sync_state state = sync_idle;
+    uint32_t interval = GSHEET_DELTA_SYNC_INTERVAL_MS, ms = 0;
+    size_t sent = 0, sentCells = 0;
+
+    void parseCell(const String &cell, uint32_t &col, uint32_t &row)
+    {
+        size_t i = 0;
+        col = 0;
+        row = 0;
+        for (; i < cell.length() && (cell[i] | 0x20) >= 'a' && (cell[i] | 0x20) <= 'z'; i++)
+            col = col * 26 + ((cell[i] | 0x20) - 'a' + 1);
+        for (; i < cell.length() && cell[i] >= '0' && cell[i] <= '9'; i++)
+            row = row * 10 + (cell[i] - '0');
+    }
+
+    bool parseRange(const String &range)
+    {
+        int p = range.lastIndexOf('!');
+        sheet = p > -1 ? range.substring(0, p + 1) : String();
+        String a1 = range.substring(p + 1);
+        int q = a1.indexOf(':');
+        if (q < 0)
+            return false;
+        uint32_t lastCol = 0, lastRow = 0;
+        parseCell(a1.substring(0, q), firstCol, firstRow);
+        parseCell(a1.substring(q + 1), lastCol, lastRow);
+        if (firstCol == 0 || firstRow == 0 || lastCol < firstCol || lastRow < firstRow)
+            return false;
+        rows = lastRow - firstRow + 1;
+        cols = lastCol - firstCol + 1;
+        return true;
+    }
+
+    void colName(String &out, uint32_t col)
+    {
+        char b[8];
+        char *p = b + sizeof(b);
+        *--p = 0;
+        while (col > 0)
+        {
+            col--;
+            *--p = 'A' + col % 26;
+            col /= 26;
+        }
+        out += p;
+    }
+
+    // The A1 range of the cells in [r1, r2) and [c1, c2) of the mirror.
+    String a1Range(uint32_t r1, uint32_t c1, uint32_t r2, uint32_t c2)
+    {
+        String str = sheet;
+        colName(str, firstCol + c1);
+        str += firstRow + r1;
+        str += ':';
+        colName(str, firstCol + c2 - 1);
+        str += firstRow + r2 - 1;
+        return str;
+    }
+
+    void resetBlocks()
+    {
+        uint32_t br = blockRows > 0 && blockRows < rows ? blockRows : rows;
+        uint32_t bc = blockCols > 0 && blockCols < cols ? blockCols : cols;
+        tileRows = br ? (rows + br - 1) / br : 0;
+        tileCols = bc ? (cols + bc - 1) / bc : 0;
+        blockRows = br;
+        blockCols = bc;
+        current.assign(tileRows * tileCols, 0);
+        dirty.assign(tileRows * tileCols, 1);
+        committed.assign(tileRows * tileCols, 0);
+        // The sheet content is unknown until pull, the empty blocks are committed as empty.
+        for (size_t i = 0; i < current.size(); i++)
+            committed[i] = hash(i);
+    }
+
+    // FNV-1a hash of the block cells.
+    uint32_t hash(uint32_t index)
+    {
+        uint32_t h = 2166136261UL;
+        uint32_t r1 = (index / tileCols) * blockRows, c1 = (index % tileCols) * blockCols;
+        for (uint32_t r = r1; r < r1 + blockRows && r < rows; r++)
+        {
+            for (uint32_t c = c1; c < c1 + blockCols && c < cols; c++)
+            {
+                const String &s = cells[r * cols + c];
+                for (size_t i = 0; i < s.length(); i++)
+                    h = (h ^ (uint8_t)s[i]) * 16777619UL;
+                h = (h ^ 0x1f) * 16777619UL;
+            }
+        }
+        return h;
+    }
+
+    void appendRows(String &out, uint32_t r1, uint32_t c1, uint32_t r2, uint32_t c2)
+    {
+        out += '[';
+        for (uint32_t r = r1; r < r2; r++)
+        {
+            out += r > r1 ? ",[" : "[";
+            for (uint32_t c = c1; c < c2; c++)
+            {
+                if (c > c1)
+                    out += ',';
+                const String &s = cells[r * cols + c];
+                if (s.length())
+                    out += s;
+                else
+                    out += FPSTR("\"\"");
+            }
+            out += ']';
+        }
+        out += ']';
+    }
+
+    String &cell(uint32_t row, uint32_t col)
+    {
+        static String none;
+        if (row >= rows || col >= cols)
+        {
+            none.remove(0, none.length());
+            return none;
+        }
+        dirty[(row / blockRows) * tileCols + col / blockCols] = 1;
+        String &s = cells[row * cols + col];
+        s.remove(0, s.length());
+        return s;
+    }
+
+    void deliver(int code, const String &message)
+    {
+        // Release the owner first, the callback may start the next pull or push.
+        gsheet_result_owner_t done = owner;
+        owner = gsheet_result_owner_t();
+        fanout.deliver(done, result.payload(), code, message);
+    }
+
+    void parsePull()
+    {
+        GSheetStringUtil sut;
+        const char *json = result.c_str();
+        size_t len = strlen(json);
+        const char *names[] = {"values"};
+        gsheet_json_span_t arr, row, item;
+        for (size_t i = 0; i < cells.size(); i++)
+            cells[i].remove(0, cells[i].length());
+
+        if (sut.scanJson(json, len, names, 1, &arr) && json[arr.start] == '[')
+        {
+            size_t pos = arr.start + 1;
+            for (uint32_t r = 0; r < rows && sut.nextJsonElement(json, len, pos, row); r++)
+            {
+                if (json[row.start] != '[')
+                    continue;
+                size_t p = row.start + 1;
+                for (uint32_t c = 0; c < cols && sut.nextJsonElement(json, row.end, p, item); c++)
+                {
+                    String &s = cells[r * cols + c];
+                    s.reserve(item.length() + 2);
+                    if (item.isString)
+                        s += '"';
+                    s.concat(json + item.start, item.length());
+                    if (item.isString)
+                        s += '"';
+                    // The empty string and empty cell are the same.
+                    if (s.length() == 2 && item.isString)
+                        s.remove(0, s.length());
+                }
+            }
+        }
+
+        for (size_t i = 0; i < current.size(); i++)
+        {
+            current[i] = committed[i] = hash(i);
+            dirty[i] = 0;
+        }
+    }
+
+    // Hash the dirty blocks and send the blocks that differ from the committed blocks.
+    bool push()
+    {
+        for (size_t i = 0; i < current.size(); i++)
+        {
+            if (dirty[i])
+            {
+                current[i] = hash(i);
+                dirty[i] = 0;
+            }
+        }
+
+        GSHEET::BatchUpdateValuesOptions options;
+        options.valueInputOption(input);
+        inflight.clear();
+        sentCells = 0;
+        String json;
+
+        // The changed blocks of each block row are joined horizontally and
+        // the ranges of the same columns in the adjacent block rows are joined vertically.
+        uint32_t pr1 = 0, pr2 = 0, pc1 = 0, pc2 = 0;
+        bool pending = false;
+        for (uint32_t tr = 0; tr <= tileRows; tr++)
+        {
+            uint32_t tc = 0;
+            while (tc <= tileCols)
+            {
+                uint32_t r1 = 0, r2 = 0, c1 = 0, c2 = 0;
+                bool found = false;
+                if (tr < tileRows)
+                {
+                    while (tc < tileCols && current[tr * tileCols + tc] == committed[tr * tileCols + tc])
+                        tc++;
+                    if (tc < tileCols)
+                    {
+                        uint32_t start = tc;
+                        while (tc < tileCols && current[tr * tileCols + tc] != committed[tr * tileCols + tc])
+                        {
+                            gsheet_sync_block_t block;
+                            block.index = tr * tileCols + tc;
+                            block.hash = current[block.index];
+                            inflight.push_back(block);
+                            tc++;
+                        }
+                        r1 = tr * blockRows;
+                        r2 = r1 + blockRows < rows ? r1 + blockRows : rows;
+                        c1 = start * blockCols;
+                        c2 = tc * blockCols < cols ? tc * blockCols : cols;
+                        found = true;
+                    }
+                }
+
+                if (pending && (found ? r1 != pr2 || c1 != pc1 || c2 != pc2 : tr == tileRows))
+                {
+                    json.remove(0, json.length());
+                    appendRows(json, pr1, pc1, pr2, pc2);
+                    GSHEET::ValueRange valueRange;
+                    valueRange.range(a1Range(pr1, pc1, pr2, pc2)).majorDimension(Dimensions::ROWS).values(gsheet_object_t(json));
+                    options.data(valueRange);
+                    sentCells += (pr2 - pr1) * (pc2 - pc1);
+                    pending = false;
+                }
+
+                if (!found)
+                    break;
+
+                if (pending)
+                    pr2 = r2;
+                else
+                {
+                    pr1 = r1;
+                    pr2 = r2;
+                    pc1 = c1;
+                    pc2 = c2;
+                    pending = true;
+                }
+            }
+        }
+
+        if (inflight.size() == 0)
+            return false;
+
+        sent += strlen(options.c_str());
+        state = sync_push;
+        result.clear();
+        values->batchUpdate(*aClient, parent, options, result);
+        return true;
+    }
+
+    bool syncImpl(GSheetAsyncResult *aResult, GSheetAsyncResultCallback cb)
+    {
+        if (!values || state != sync_idle)
+            return false;
+        ms = millis();
+        owner = gsheet_result_owner_t(aResult, cb);
+        if (aResult)
+            aResult->clear();
+        if (!push())
+        {
+            owner = gsheet_result_owner_t();
+            return false;
+        }
+        return true;
+    }
+
+    bool pullImpl(GSheetAsyncResult *aResult, GSheetAsyncResultCallback cb)
+    {
+        if (!values || state != sync_idle)
+            return false;
+        owner = gsheet_result_owner_t(aResult, cb);
+        if (aResult)
+            aResult->clear();
+        GSHEET::BatchGetOptions options;
+        options.ranges(a1Range(0, 0, rows, cols));
+        options.majorDimension(Dimensions::ROWS).valueRenderOption(GSHEET::UNFORMATTED_VALUE);
+        state = sync_pull;
+        result.clear();
+        values->batchGet(*aClient, parent, options, result);
+        return true;
+    }
+
+public:
+    GSheetDeltaSync() {}
+
+    /**
+     * Set the range to mirror.
+     *
+     * @param values The Values object that used to send the requests.
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param range The A1 notation of the range with the start and end cells e.g. Sheet1!A1:F50.
+     * @param input How the input data should be interpreted, GSHEET::RAW or GSHEET::USER_ENTERED.
+     * @return bool The range is valid.
+     */
+    bool begin(Values &values, GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const String &range, GSHEET::ValueInputOption input = GSHEET::RAW)
+    {
+        if (!parseRange(range))
+            return false;
+        this->values = &values;
+        this->aClient = &aClient;
+        this->parent = parent;
+        this->input = input;
+        cells.assign(rows * cols, String());
+        blockRows = GSHEET_DELTA_SYNC_BLOCK_ROWS;
+        blockCols = GSHEET_DELTA_SYNC_BLOCK_COLS;
+        resetBlocks();
+        state = sync_idle;
+        ms = millis();
+        return true;
+    }
+
+    /**
+     * Set the size of the hashed block.
+     * The local cells are kept and the whole range is sent in the next sync.
+     *
+     * @param rows The number of rows of block.
+     * @param cols The number of columns of block, 0 for all columns of the range.
+     */
+    void setBlock(uint32_t rows, uint32_t cols = 0)
+    {
+        if (state != sync_idle)
+            return;
+        blockRows = rows;
+        blockCols = cols;
+        resetBlocks();
+        invalidate();
+    }
+
+    /**
+     * Set the interval that the changed blocks are sent from loop.
+     * @param ms The interval in milliseconds, 0 to send only when sync is called.
+     */
+    void setInterval(uint32_t ms) { interval = ms; }
+
+    /**
+     * Set the cell value in the mirror.
+     * @param row The zero-based row in the range.
+     * @param col The zero-based column in the range.
+     * @param value The cell value.
+     */
+    template <typename T>
+    auto set(uint32_t row, uint32_t col, T value) -> typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, GSheetDeltaSync &>::type
+    {
+        GSheetJSONUtil jut;
+        jut.appendInt(cell(row, col), value);
+        return *this;
+    }
+
+    template <typename T>
+    auto set(uint32_t row, uint32_t col, T value) -> typename std::enable_if<std::is_floating_point<T>::value, GSheetDeltaSync &>::type
+    {
+        GSheetJSONUtil jut;
+        jut.appendDouble(cell(row, col), value);
+        return *this;
+    }
+
+    GSheetDeltaSync &set(uint32_t row, uint32_t col, bool value)
+    {
+        cell(row, col) += value ? FPSTR("true") : FPSTR("false");
+        return *this;
+    }
+
+    GSheetDeltaSync &set(uint32_t row, uint32_t col, const char *value)
+    {
+        GSheetJSONUtil jut;
+        String &s = cell(row, col);
+        if (value && *value)
+            jut.appendString(s, value, strlen(value));
+        return *this;
+    }
+
+    GSheetDeltaSync &set(uint32_t row, uint32_t col, const String &value) { return set(row, col, value.c_str()); }
+
+    /**
+     * Clear the cell value in the mirror.
+     * @param row The zero-based row in the range.
+     * @param col The zero-based column in the range.
+     */
+    GSheetDeltaSync &clearCell(uint32_t row, uint32_t col)
+    {
+        cell(row, col);
+        return *this;
+    }
+
+    /**
+     * Get the cell value in JSON e.g. 12.5, true or "text" or empty string for empty cell.
+     * @param row The zero-based row in the range.
+     * @param col The zero-based column in the range.
+     */
+    const char *get(uint32_t row, uint32_t col) const { return row < rows && col < cols ? cells[row * cols + col].c_str() : ""; }
+
+    /**
+     * Load the mirror from the sheet and commit it, the sync sends only the later changes.
+     * @param aResult The async result (GSheetAsyncResult).
+     * @return bool The request was sent.
+     */
+    bool pull(GSheetAsyncResult &aResult) { return pullImpl(&aResult, NULL); }
+
+    /**
+     * Load the mirror from the sheet and commit it, the sync sends only the later changes.
+     * @param cb The async result callback (GSheetAsyncResultCallback).
+     * @return bool The request was sent.
+     */
+    bool pull(GSheetAsyncResultCallback cb = NULL) { return pullImpl(nullptr, cb); }
+
+    /**
+     * Send the changed blocks.
+     * @param aResult The async result (GSheetAsyncResult).
+     * @return bool The request was sent, false when no block was changed or the previous request is in progress.
+     */
+    bool sync(GSheetAsyncResult &aResult) { return syncImpl(&aResult, NULL); }
+
+    /**
+     * Send the changed blocks.
+     * @param cb The async result callback (GSheetAsyncResultCallback).
+     * @return bool The request was sent, false when no block was changed or the previous request is in progress.
+     */
+    bool sync(GSheetAsyncResultCallback cb = NULL) { return syncImpl(nullptr, cb); }
+
+    /**
+     * Mark all blocks as not committed, the next sync sends the whole range.
+     */
+    void invalidate()
+    {
+        for (size_t i = 0; i < committed.size(); i++)
+            committed[i] = ~hash(i);
+    }
+
+    /**
+     * Perform the sync tasks repeatedly.
+     * Should be places in main loop function.
+     */
+    void loop()
+    {
+        if (!values)
+            return;
+
+        if (state != sync_idle)
+        {
+            bool failed = result.isError();
+            if (failed || result.available())
+            {
+                String message;
+                int code = fanout.takeError(result, failed, message);
+
+                if (!failed && state == sync_pull)
+                    parsePull();
+                else if (!failed)
+                {
+                    for (size_t i = 0; i < inflight.size(); i++)
+                        committed[inflight[i].index] = inflight[i].hash;
+                }
+                inflight.clear();
+                state = sync_idle;
+                deliver(code, message);
+            }
+        }
+        else if (interval > 0 && millis() - ms >= interval)
+        {
+            ms = millis();
+            syncImpl(nullptr, NULL);
+        }
+
+        values->loop();
+    }
+
+    /**
+     * Check whether the pull or sync request is in progress.
+     * @return bool The request status.
+     */
+    bool busy() const { return state != sync_idle; }
+
+    /**
+     * Get the total bytes of the sent values:batchUpdate payloads.
+     * @return size_t The number of bytes.
+     */
+    size_t bytesSent() const { return sent; }
+
+    /**
+     * Get the number of cells of the last sync.
+     * @return size_t The number of cells.
+     */
+    size_t cellsSent() const { return sentCells; }
+};
+
+#endif
@@ -27,11 +27,15 @@
 #define GSHEET_BASE_H
 
 #include <Arduino.h>
+#include <utility>
 #include "./core/GSheetApp.h"
 #include "./spreadsheets/DataOptions.h"
 
 class GSheetBase
 {
+    friend class GSheetAppBase;
+    friend class GSheetBulkWriter;
+
 private:
     void url(const String &url)
     {
@@ -117,6 +121,9 @@ public:
      */
     void batchUpdate(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const GSHEET::BatchUpdateOptions &options, GSheetAsyncResult &aResult)
     {
+        String path = spreadsheetPath(parent);
+        path += FPSTR(":batchUpdate");
+        sendRequest(aClient, &aResult, NULL, "", path, "", gsheet_async_request_handler_t::http_post, options.c_str());
     }
 
     /** Creates a spreadsheet, returning the newly created spreadsheet.
@@ -153,6 +160,15 @@ public:
      */
     void get(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, GSHEET::GetOptions options, GSheetAsyncResult &aResult)
     {
+        String path = spreadsheetPath(parent);
+        // The dataFilters are sent in the body of getByDataFilter request.
+        if (strlen(options.c_str()))
+        {
+            path += FPSTR(":getByDataFilter");
+            sendRequest(aClient, &aResult, NULL, "", path, options.getQueryString(), gsheet_async_request_handler_t::http_post, options.c_str());
+        }
+        else
+            sendRequest(aClient, &aResult, NULL, "", path, options.getQueryString(), gsheet_async_request_handler_t::http_get, "");
     }
 
     /** Delete spreadsheets from Google Drive.
@@ -193,6 +209,28 @@ protected:
     String uid;
     gsheet_app_token_t *app_token = nullptr;
 
+    // The path of spreadsheet resource e.g. /v4/spreadsheets/<spreadsheetId>
+    String spreadsheetPath(const GSHEET::Parent &parent)
+    {
+        String str = FPSTR("/v4/spreadsheets/");
+        str += parent.getSpreadsheetId();
+        return str;
+    }
+
+    // The payload is taken by value and moved to the slot, the built body e.g. of GSheetBulkWriter is not copied.
+    void sendRequest(GSheetAsyncClientClass &aClient, GSheetAsyncResult *aResult, GSheetAsyncResultCallback cb, const String &uid, const String &path, const String &query, gsheet_async_request_handler_t::http_request_method method, String payload)
+    {
+        GSHEET::DataOptions options;
+        if (query.length())
+        {
+            options.extras = '?';
+            options.extras += query;
+        }
+        options.payload = std::move(payload);
+        async_request_data_t aReq(&aClient, path, method, gsheet_slot_options_t(false, true), &options, aResult, cb, uid);
+        asyncRequest(aReq);
+    }
+
     struct async_request_data_t
     {
     public:
@@ -217,6 +255,60 @@ protected:
             this->uid = uid;
         }
     };
+
+    void asyncRequest(async_request_data_t &request)
+    {
+        gsheet_app_token_t *atoken = appToken();
+        if (!atoken)
+            return setClientError(request, GSHEET_ERROR_APP_WAS_NOT_ASSIGNED);
+
+        request.opt.app_token = atoken;
+        url(FPSTR("sheets.googleapis.com"));
+
+        gsheet_async_data_item_t *sData = request.aClient->createSlot(request.opt);
+
+        if (!sData)
+            return setClientError(request, GSHEET_ERROR_OPERATION_CANCELLED);
+
+        request.aClient->newRequest(sData, service_url, request.path, request.options ? request.options->extras : "", request.method, request.opt, request.uid);
+
+        if (request.method == gsheet_async_request_handler_t::http_post || request.method == gsheet_async_request_handler_t::http_put || request.method == gsheet_async_request_handler_t::http_patch)
+        {
+            if (request.options)
+                sData->request.val[gsheet_req_hndlr_ns::payload] = std::move(request.options->payload);
+            request.aClient->setContentType(sData, "application/json");
+            request.aClient->setContentLength(sData, sData->request.val[gsheet_req_hndlr_ns::payload].length());
+        }
+
+        if (request.cb)
+            sData->cb = request.cb;
+
+        if (request.aResult)
+            sData->setRefResult(request.aResult, reinterpret_cast<uint32_t>(&(request.aClient->rVec)));
+
+        request.aClient->addRemoveClientVec(reinterpret_cast<uint32_t>(&(cVec)), true);
+        request.aClient->process(sData->async);
+        request.aClient->handleRemove();
+    }
+
+    void setClientError(async_request_data_t &request, int code)
+    {
+        GSheetAsyncResult *aResult = request.aResult;
+
+        if (!aResult)
+            aResult = new GSheetAsyncResult();
+
+        aResult->error().setClientError(code);
+
+        if (request.cb)
+            request.cb(*aResult);
+
+        if (!request.aResult)
+        {
+            delete aResult;
+            aResult = nullptr;
+        }
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,615 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2026 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GSHEET_RANGE_CACHE_H
+#define GSHEET_RANGE_CACHE_H
+
+#include <Arduino.h>
+#include "./spreadsheets/Values.h"
+#include "./core/AsyncResult/ResultFanout.h"
+
+// The default time in milliseconds that the cached range is valid.
+#if !defined(GSHEET_RANGE_CACHE_TTL_MS)
+#define GSHEET_RANGE_CACHE_TTL_MS 30000
+#endif
+
+// The default memory budget in bytes of the cached ranges, the least recently used ranges are removed when it was exceeded.
+#if !defined(GSHEET_RANGE_CACHE_BUDGET)
+#define GSHEET_RANGE_CACHE_BUDGET 4096
+#endif
+
+// The cell area of A1 range, the missing bounds are open (0 or UINT32_MAX).
+struct gsheet_a1_rect_t
+{
+    String sheet;
+    uint32_t c1 = 0, r1 = 0, c2 = UINT32_MAX, r2 = UINT32_MAX;
+};
+
+/**
+ * The read-through cache of the values.get and values:batchGet results.
+ *
+ * The ranges are keyed by spreadsheet Id, normalized A1 range and the render options.
+ * The cache hits complete the async result and callback immediately without network request.
+ * The writes that are sent through the cache (update, append and batchUpdate) remove the overlapping ranges
+ * when they complete, and the reads that were in flight during an overlapping write are not kept,
+ * so the reads after the write always see it.
+ */
+class GSheetRangeCache
+{
+private:
+    enum op_type
+    {
+        op_get,
+        op_batch_get,
+        op_write
+    };
+
+    struct gsheet_cache_entry_t
+    {
+        String spreadsheetId;
+        String key;
+        String payload;
+        gsheet_a1_rect_t rect;
+        uint32_t ts = 0, ttl = 0, used = 0;
+    };
+
+    struct gsheet_cache_op_t
+    {
+        op_type type = op_get;
+        String spreadsheetId;
+        String opts;
+        std::vector<String> keys;
+        std::vector<gsheet_a1_rect_t> rects;
+        std::vector<gsheet_result_owner_t> owners;
+        GSheetAsyncResult result;
+        uint32_t ttl = 0, seq = 0, doneSeq = 0;
+        bool done = false;
+    };
+
+    Values *values = nullptr;
+    std::vector<gsheet_cache_entry_t> entries;
+    std::vector<gsheet_cache_op_t *> ops;
+    GSheetResultFanout fanout;
+    size_t budget = GSHEET_RANGE_CACHE_BUDGET, bytes = 0;
+    uint32_t ttl = GSHEET_RANGE_CACHE_TTL_MS, useCount = 0, seq = 0, hitCount = 0, missCount = 0;
+
+    uint32_t colNum(const String &s, size_t &i)
+    {
+        uint32_t n = 0;
+        for (; i < s.length() && (s[i] | 0x20) >= 'a' && (s[i] | 0x20) <= 'z'; i++)
+            n = n * 26 + ((s[i] | 0x20) - 'a' + 1);
+        return n;
+    }
+
+    uint32_t rowNum(const String &s, size_t &i)
+    {
+        uint32_t n = 0;
+        for (; i < s.length() && s[i] >= '0' && s[i] <= '9'; i++)
+            n = n * 10 + (s[i] - '0');
+        return n;
+    }
+
+    // The sheet name without the quotes, 'Sheet1' and Sheet1 are the same sheet.
+    String sheetName(const String &s)
+    {
+        if (s.length() < 2 || s[0] != '\'' || s[s.length() - 1] != '\'')
+            return s;
+        String name;
+        name.reserve(s.length() - 2);
+        for (size_t i = 1; i < s.length() - 1; i++)
+        {
+            name += s[i];
+            if (s[i] == '\'' && s[i + 1] == '\'' && i + 1 < s.length() - 1)
+                i++;
+        }
+        return name;
+    }
+
+    gsheet_a1_rect_t toRect(const String &range)
+    {
+        GSheetStringUtil sut;
+        String key = sut.normalizeA1(range);
+        gsheet_a1_rect_t rect;
+        int p = key.lastIndexOf('!');
+        rect.sheet = p > -1 ? sheetName(key.substring(0, p)) : String();
+        String cells = key.substring(p + 1);
+        if (cells.length() == 0)
+            return rect;
+
+        int q = cells.indexOf(':');
+        String a = q > -1 ? cells.substring(0, q) : cells, b = q > -1 ? cells.substring(q + 1) : cells;
+        size_t i = 0, j = 0;
+        uint32_t c1 = colNum(a, i), r1 = rowNum(a, i), c2 = colNum(b, j), r2 = rowNum(b, j);
+
+        // The range that is not A1 notation e.g. the named range or the sheet name only, may refer to any sheet
+        // and overlaps all ranges of the spreadsheet. The columns are limited to three letters (ZZZ).
+        if (i < a.length() || j < b.length() || c1 > 18278 || c2 > 18278)
+        {
+            rect.sheet.remove(0, rect.sheet.length());
+            return rect;
+        }
+
+        rect.c1 = c1;
+        rect.r1 = r1;
+        rect.c2 = c2 ? c2 : UINT32_MAX;
+        rect.r2 = r2 ? r2 : UINT32_MAX;
+        return rect;
+    }
+
+    // The range without sheet name is on the first sheet that is unknown here, it overlaps all sheets.
+    bool overlap(const gsheet_a1_rect_t &a, const gsheet_a1_rect_t &b)
+    {
+        if (a.sheet.length() && b.sheet.length() && a.sheet != b.sheet)
+            return false;
+        return a.c1 <= b.c2 && b.c1 <= a.c2 && a.r1 <= b.r2 && b.r1 <= a.r2;
+    }
+
+    String makeKey(const String &spreadsheetId, const String &range, const String &opts)
+    {
+        GSheetStringUtil sut;
+        String key = spreadsheetId;
+        key += '/';
+        key += sut.normalizeA1(range);
+        if (opts.length())
+        {
+            key += '?';
+            key += opts;
+        }
+        return key;
+    }
+
+    int find(const String &key)
+    {
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            if (entries[i].key == key)
+            {
+                if (millis() - entries[i].ts < entries[i].ttl)
+                    return i;
+                remove(i);
+                return -1;
+            }
+        }
+        return -1;
+    }
+
+    void remove(size_t i)
+    {
+        bytes -= entries[i].key.length() + entries[i].payload.length();
+        entries.erase(entries.begin() + i);
+    }
+
+    void store(const gsheet_cache_op_t &op, size_t index, const char *payload, size_t len)
+    {
+        int i = find(op.keys[index]);
+        if (i > -1)
+            remove(i);
+
+        if (op.keys[index].length() + len > budget)
+            return;
+
+        gsheet_cache_entry_t entry;
+        entry.spreadsheetId = op.spreadsheetId;
+        entry.key = op.keys[index];
+        entry.rect = op.rects[index];
+        entry.payload.reserve(len);
+        entry.payload.concat(payload, len);
+        entry.ts = millis();
+        entry.ttl = op.ttl;
+        entry.used = ++useCount;
+        bytes += entry.key.length() + len;
+        entries.push_back(entry);
+
+        // Remove the least recently used ranges until the cache fits its budget.
+        while (bytes > budget && entries.size())
+        {
+            size_t lru = 0;
+            for (size_t k = 1; k < entries.size(); k++)
+            {
+                if (entries[k].used < entries[lru].used)
+                    lru = k;
+            }
+            remove(lru);
+        }
+    }
+
+    void removeOverlap(const String &spreadsheetId, const gsheet_a1_rect_t &rect)
+    {
+        for (int i = entries.size() - 1; i >= 0; i--)
+        {
+            if (entries[i].spreadsheetId == spreadsheetId && overlap(entries[i].rect, rect))
+                remove(i);
+        }
+    }
+
+    // The read result is not kept if an overlapping write was in flight or completed after the read was sent.
+    bool storable(const gsheet_cache_op_t &op, size_t index)
+    {
+        for (size_t i = 0; i < ops.size(); i++)
+        {
+            const gsheet_cache_op_t *w = ops[i];
+            if (w->type != op_write || w->spreadsheetId != op.spreadsheetId || (w->done && w->doneSeq <= op.seq))
+                continue;
+            for (size_t j = 0; j < w->rects.size(); j++)
+            {
+                if (overlap(w->rects[j], op.rects[index]))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    gsheet_cache_op_t *newOp(op_type type, const GSHEET::Parent &parent, GSheetAsyncResult *aResult, GSheetAsyncResultCallback cb)
+    {
+        gsheet_cache_op_t *op = new gsheet_cache_op_t();
+        op->type = type;
+        op->spreadsheetId = parent.getSpreadsheetId();
+        op->seq = seq;
+        op->owners.push_back(gsheet_result_owner_t(aResult, cb));
+        if (aResult)
+            aResult->clear();
+        ops.push_back(op);
+        return op;
+    }
+
+    void getImpl(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const String &range, GSheetAsyncResult *aResult, GSheetAsyncResultCallback cb, uint32_t ttl)
+    {
+        String key = makeKey(parent.getSpreadsheetId(), range, "");
+        gsheet_result_owner_t owner(aResult, cb);
+
+        int i = find(key);
+        if (i > -1)
+        {
+            hitCount++;
+            entries[i].used = ++useCount;
+            fanout.deliver(owner, entries[i].payload, 0, "");
+            return;
+        }
+
+        missCount++;
+
+        // Share the pending read of the same range.
+        for (size_t k = 0; k < ops.size(); k++)
+        {
+            if (ops[k]->type == op_get && !ops[k]->done && ops[k]->keys[0] == key)
+            {
+                if (aResult)
+                    aResult->clear();
+                ops[k]->owners.push_back(owner);
+                return;
+            }
+        }
+
+        gsheet_cache_op_t *op = newOp(op_get, parent, aResult, cb);
+        op->keys.push_back(key);
+        op->rects.push_back(toRect(range));
+        op->ttl = ttl ? ttl : this->ttl;
+        values->get(aClient, parent, range, op->result);
+    }
+
+    void batchGetImpl(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const GSHEET::BatchGetOptions &options, GSheetAsyncResult *aResult, GSheetAsyncResultCallback cb, uint32_t ttl)
+    {
+        String opts;
+        for (size_t i = 1; i < GSHEET::BatchGetOptions::bufSize; i++)
+        {
+            if (options.qr[i].length())
+            {
+                if (opts.length())
+                    opts += '&';
+                opts += options.qr[i];
+            }
+        }
+
+        String spreadsheetId = parent.getSpreadsheetId();
+        std::vector<int> hits;
+        for (size_t i = 0; i < options.rangeList.size(); i++)
+        {
+            int k = find(makeKey(spreadsheetId, options.rangeList[i], opts));
+            if (k < 0)
+                break;
+            hits.push_back(k);
+        }
+
+        if (options.rangeList.size() && hits.size() == options.rangeList.size())
+        {
+            hitCount++;
+            String payload = FPSTR("{\"spreadsheetId\":\"");
+            payload += spreadsheetId;
+            payload += FPSTR("\",\"valueRanges\":[");
+            for (size_t i = 0; i < hits.size(); i++)
+            {
+                if (i > 0)
+                    payload += ',';
+                payload += entries[hits[i]].payload;
+                entries[hits[i]].used = ++useCount;
+            }
+            payload += FPSTR("]}");
+            fanout.deliver(gsheet_result_owner_t(aResult, cb), payload, 0, "");
+            return;
+        }
+
+        missCount++;
+        gsheet_cache_op_t *op = newOp(op_batch_get, parent, aResult, cb);
+        op->opts = opts;
+        op->ttl = ttl ? ttl : this->ttl;
+        for (size_t i = 0; i < options.rangeList.size(); i++)
+        {
+            op->keys.push_back(makeKey(spreadsheetId, options.rangeList[i], opts));
+            op->rects.push_back(toRect(options.rangeList[i]));
+        }
+        values->batchGet(aClient, parent, options, op->result);
+    }
+
+    gsheet_cache_op_t *newWrite(const GSHEET::Parent &parent, GSheetAsyncResult *aResult, GSheetAsyncResultCallback cb)
+    {
+        seq++;
+        return newOp(op_write, parent, aResult, cb);
+    }
+
+    // Remove the overlapping ranges when the write is queued, the hits should not return the values it replaces.
+    void removeWritten(const gsheet_cache_op_t &op)
+    {
+        for (size_t i = 0; i < op.rects.size(); i++)
+            removeOverlap(op.spreadsheetId, op.rects[i]);
+    }
+
+    void complete(gsheet_cache_op_t *op, bool failed)
+    {
+        GSheetStringUtil sut;
+        String message;
+        int code = fanout.takeError(op->result, failed, message);
+
+        const char *json = op->result.c_str();
+        size_t len = strlen(json);
+
+        if (!failed && op->type == op_get && storable(*op, 0))
+            store(*op, 0, json, len);
+        else if (!failed && op->type == op_batch_get)
+        {
+            const char *names[] = {"valueRanges"};
+            gsheet_json_span_t arr, item;
+            if (sut.scanJson(json, len, names, 1, &arr) && json[arr.start] == '[')
+            {
+                size_t pos = arr.start + 1;
+                for (size_t i = 0; i < op->keys.size() && sut.nextJsonElement(json, len, pos, item); i++)
+                {
+                    if (storable(*op, i))
+                        store(*op, i, json + item.start, item.length());
+                }
+            }
+        }
+        else if (!failed && op->type == op_write)
+            removeWritten(*op);
+
+        op->done = true;
+        op->doneSeq = ++seq;
+
+        std::vector<gsheet_result_owner_t> owners;
+        owners.swap(op->owners);
+        String payload = op->result.payload();
+        for (size_t i = 0; i < owners.size(); i++)
+            fanout.deliver(owners[i], payload, code, message);
+    }
+
+    // Remove the completed operations, the writes are kept while the reads that were sent before they completed are pending.
+    void trim()
+    {
+        uint32_t minSeq = seq;
+        for (size_t i = 0; i < ops.size(); i++)
+        {
+            if (ops[i]->type != op_write && !ops[i]->done && ops[i]->seq < minSeq)
+                minSeq = ops[i]->seq;
+        }
+
+        for (int i = ops.size() - 1; i >= 0; i--)
+        {
+            if (ops[i]->done && (ops[i]->type != op_write || ops[i]->doneSeq <= minSeq))
+            {
+                delete ops[i];
+                ops.erase(ops.begin() + i);
+            }
+        }
+    }
+
+public:
+    GSheetRangeCache() {}
+    ~GSheetRangeCache()
+    {
+        for (size_t i = 0; i < ops.size(); i++)
+            delete ops[i];
+    }
+
+    /**
+     * Set the Values object and the cache limits.
+     *
+     * @param values The Values object that used to send the requests.
+     * @param budget The memory budget in bytes of the cached ranges.
+     * @param ttl The default time in milliseconds that the cached range is valid.
+     */
+    void begin(Values &values, size_t budget = GSHEET_RANGE_CACHE_BUDGET, uint32_t ttl = GSHEET_RANGE_CACHE_TTL_MS)
+    {
+        this->values = &values;
+        this->budget = budget;
+        this->ttl = ttl;
+    }
+
+    /** Get a range of values from the cache or from the spreadsheet when it is not cached.
+     *
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param range The A1 notation of the range to retrieve values from.
+     * @param aResult The async result (GSheetAsyncResult).
+     * @param ttl The time in milliseconds that the range is cached, 0 for the default.
+     */
+    void get(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const String &range, GSheetAsyncResult &aResult, uint32_t ttl = 0) { getImpl(aClient, parent, range, &aResult, NULL, ttl); }
+
+    /** Get a range of values from the cache or from the spreadsheet when it is not cached.
+     *
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param range The A1 notation of the range to retrieve values from.
+     * @param cb The async result callback (GSheetAsyncResultCallback).
+     * @param ttl The time in milliseconds that the range is cached, 0 for the default.
+     */
+    void get(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const String &range, GSheetAsyncResultCallback cb, uint32_t ttl = 0) { getImpl(aClient, parent, range, nullptr, cb, ttl); }
+
+    /** Get one or more ranges of values from the cache or from the spreadsheet when any range is not cached.
+     *
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param options The GSHEET::BatchGetOptions object included ranges, majorDimension, valueRenderOption and dateTimeRenderOption.
+     * @param aResult The async result (GSheetAsyncResult).
+     * @param ttl The time in milliseconds that the ranges are cached, 0 for the default.
+     */
+    void batchGet(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const GSHEET::BatchGetOptions &options, GSheetAsyncResult &aResult, uint32_t ttl = 0) { batchGetImpl(aClient, parent, options, &aResult, NULL, ttl); }
+
+    /** Get one or more ranges of values from the cache or from the spreadsheet when any range is not cached.
+     *
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param options The GSHEET::BatchGetOptions object included ranges, majorDimension, valueRenderOption and dateTimeRenderOption.
+     * @param cb The async result callback (GSheetAsyncResultCallback).
+     * @param ttl The time in milliseconds that the ranges are cached, 0 for the default.
+     */
+    void batchGet(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const GSHEET::BatchGetOptions &options, GSheetAsyncResultCallback cb, uint32_t ttl = 0) { batchGetImpl(aClient, parent, options, nullptr, cb, ttl); }
+
+    /** Sets values in a range of a spreadsheet, the overlapping cached ranges are removed.
+     * The parameters are the same as Values::update.
+     */
+    void update(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const String &range, const GSHEET::ValueRange &valueRange, const GSHEET::UpdateOptions &options, GSheetAsyncResult &aResult)
+    {
+        gsheet_cache_op_t *op = newWrite(parent, &aResult, NULL);
+        op->rects.push_back(toRect(range));
+        removeWritten(*op);
+        values->update(aClient, parent, range, valueRange, options, op->result);
+    }
+
+    /** Appends values to a spreadsheet, the cached ranges of the same sheet are removed.
+     * The parameters are the same as Values::append.
+     */
+    void append(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const String &range, const GSHEET::ValueRange &valueRange, const GSHEET::AppendOptions &options, GSheetAsyncResult &aResult)
+    {
+        gsheet_cache_op_t *op = newWrite(parent, &aResult, NULL);
+        gsheet_a1_rect_t rect;
+        rect.sheet = toRect(range).sheet;
+        op->rects.push_back(rect);
+        removeWritten(*op);
+        values->append(aClient, parent, range, valueRange, options, op->result);
+    }
+
+    /** Sets values in one or more ranges of a spreadsheet, the overlapping cached ranges are removed.
+     * The parameters are the same as Values::batchUpdate.
+     */
+    void batchUpdate(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const GSHEET::BatchUpdateValuesOptions &options, GSheetAsyncResult &aResult)
+    {
+        GSheetStringUtil sut;
+        gsheet_cache_op_t *op = newWrite(parent, &aResult, NULL);
+        const char *json = options.c_str();
+        size_t len = strlen(json);
+        const char *names[] = {"data"}, *rangeName[] = {"range"};
+        gsheet_json_span_t arr, item;
+        if (sut.scanJson(json, len, names, 1, &arr) && json[arr.start] == '[')
+        {
+            size_t pos = arr.start + 1;
+            String range;
+            while (sut.nextJsonElement(json, len, pos, item))
+            {
+                gsheet_json_span_t span;
+                if (sut.scanJson(json + item.start, item.length(), rangeName, 1, &span))
+                {
+                    span.start += item.start;
+                    span.end += item.start;
+                    sut.spanStr(json, span, range);
+                    op->rects.push_back(toRect(range));
+                }
+            }
+        }
+
+        // The unknown ranges overlap all ranges of the spreadsheet.
+        if (op->rects.size() == 0)
+            op->rects.push_back(gsheet_a1_rect_t());
+        removeWritten(*op);
+        values->batchUpdate(aClient, parent, options, op->result);
+    }
+
+    /**
+     * Remove the cached ranges that overlap the range.
+     *
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param range The A1 notation of the range, the empty range removes all ranges of the spreadsheet.
+     */
+    void invalidate(const GSHEET::Parent &parent, const String &range = "") { removeOverlap(parent.getSpreadsheetId(), toRect(range)); }
+
+    /**
+     * Remove all cached ranges.
+     */
+    void clear()
+    {
+        entries.clear();
+        bytes = 0;
+    }
+
+    /**
+     * Perform the cache tasks repeatedly.
+     * Should be places in main loop function.
+     */
+    void loop()
+    {
+        if (!values)
+            return;
+
+        for (size_t i = 0; i < ops.size(); i++)
+        {
+            if (ops[i]->done)
+                continue;
+            bool failed = ops[i]->result.isError();
+            if (failed || ops[i]->result.available())
+                complete(ops[i], failed);
+        }
+
+        trim();
+        values->loop();
+    }
+
+    /**
+     * Get the memory used by the cached ranges.
+     * @return size_t The number of bytes.
+     */
+    size_t size() const { return bytes; }
+
+    /**
+     * Get the number of reads that were served from the cache.
+     * @return uint32_t The number of cache hits.
+     */
+    uint32_t hits() const { return hitCount; }
+
+    /**
+     * Get the number of reads that were sent to the spreadsheet.
+     * @return uint32_t The number of cache misses.
+     */
+    uint32_t misses() const { return missCount; }
+};
+
+#endif
@@ -0,0 +1,458 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2026 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GSHEET_RANGE_READER_H
+#define GSHEET_RANGE_READER_H
+
+#include <Arduino.h>
+#include "./spreadsheets/Values.h"
+
+// The maximum number of async clients (connections) that fetch the row blocks concurrently.
+#if !defined(GSHEET_RANGE_READER_MAX_CONNECTIONS)
+#define GSHEET_RANGE_READER_MAX_CONNECTIONS 4
+#endif
+
+// The response time in milliseconds that the block size is adjusted to.
+#if !defined(GSHEET_RANGE_READER_TARGET_MS)
+#define GSHEET_RANGE_READER_TARGET_MS 3000
+#endif
+
+#if !defined(GSHEET_RANGE_READER_MIN_ROWS)
+#define GSHEET_RANGE_READER_MIN_ROWS 50
+#endif
+
+#if !defined(GSHEET_RANGE_READER_MAX_ROWS)
+#define GSHEET_RANGE_READER_MAX_ROWS 5000
+#endif
+
+// The number of times the failed block is split and requested again before the read was aborted.
+#if !defined(GSHEET_RANGE_READER_MAX_RETRY)
+#define GSHEET_RANGE_READER_MAX_RETRY 2
+#endif
+
+/**
+ * The row callback of GSheetRangeReader.
+ * @param row The 1-based row number in the sheet.
+ * @param data The row JSON array e.g. ["a",1,true], it is not null terminated.
+ * @param len The length of row JSON array.
+ */
+typedef void (*GSheetRowCallback)(uint32_t row, const char *data, size_t len);
+
+/**
+ * Read the large A1 range e.g. Sheet1!A1:F200000 in row blocks.
+ *
+ * The blocks are fetched concurrently by the async clients with Values::get and the rows are
+ * streamed to the row callback (or assembled as one JSON array) in the sheet order.
+ * The block size is adjusted to keep the response time close to GSHEET_RANGE_READER_TARGET_MS.
+ *
+ * The range without end row e.g. Sheet1!A2:F is read until the block that has no rows or the last row of sheet.
+ * The block that failed with the timeout, rate limit or server error is split and requested again.
+ */
+class GSheetRangeReader
+{
+private:
+    enum conn_state
+    {
+        conn_idle,
+        conn_busy,
+        conn_ready
+    };
+
+    struct gsheet_range_conn_t
+    {
+        GSheetAsyncClientClass *client = nullptr;
+        GSheetAsyncResult result;
+        conn_state state = conn_idle;
+        uint32_t first = 0, rows = 0, ms = 0;
+        uint8_t retry = 0;
+    };
+
+    struct gsheet_row_span_t
+    {
+        uint32_t first = 0, rows = 0;
+        uint8_t retry = 0;
+    };
+
+    Values *values = nullptr;
+    GSHEET::Parent parent;
+    GSheetRowCallback cb = NULL;
+    gsheet_range_conn_t conn[GSHEET_RANGE_READER_MAX_CONNECTIONS];
+    size_t connCount = 0;
+    // The split blocks of the failed requests, sorted by first row.
+    std::vector<gsheet_row_span_t> pending;
+    String sheet, startCol, endCol, out;
+    uint32_t nextRow = 0, nextEmit = 0, endRow = 0, blockRows = GSHEET_RANGE_READER_MIN_ROWS, rowCount = 0, lastRow = 0;
+    bool openEnded = false, gridEnded = false, active = false, ended = false;
+    GSheetError err;
+
+    // Split the column letters and row number of A1 cell e.g. AB12.
+    void parseCell(const String &cell, String &col, uint32_t &row)
+    {
+        size_t i = 0;
+        while (i < cell.length() && (cell[i] | 0x20) >= 'a' && (cell[i] | 0x20) <= 'z')
+            i++;
+        col = cell.substring(0, i);
+        row = 0;
+        for (; i < cell.length() && cell[i] >= '0' && cell[i] <= '9'; i++)
+            row = row * 10 + (cell[i] - '0');
+    }
+
+    bool parseRange(const String &range)
+    {
+        int p = range.lastIndexOf('!');
+        sheet = p > -1 ? range.substring(0, p + 1) : String();
+        String cells = range.substring(p + 1);
+        int q = cells.indexOf(':');
+        uint32_t startRow = 0;
+        parseCell(q > -1 ? cells.substring(0, q) : cells, startCol, startRow);
+        parseCell(q > -1 ? cells.substring(q + 1) : cells, endCol, endRow);
+        nextRow = startRow > 0 ? startRow : 1;
+        openEnded = endRow == 0;
+        gridEnded = openEnded;
+        return openEnded || endRow >= nextRow;
+    }
+
+    String blockRange(uint32_t first, uint32_t rows)
+    {
+        String str = sheet;
+        str += startCol;
+        str += first;
+        str += ':';
+        str += endCol;
+        str += first + rows - 1;
+        return str;
+    }
+
+    bool done() const { return ended || (!openEnded && nextEmit > endRow); }
+
+    void dispatch(gsheet_range_conn_t &c, uint32_t first, uint32_t rows, uint8_t retry)
+    {
+        c.first = first;
+        c.rows = rows;
+        c.retry = retry;
+        c.state = conn_busy;
+        c.ms = millis();
+        c.result.clear();
+        values->get(*c.client, parent, blockRange(first, rows), c.result);
+    }
+
+    // Take the next block, the split blocks of failed requests come first.
+    bool nextBlock(gsheet_row_span_t &span)
+    {
+        // The split blocks past the last row of sheet are dropped.
+        while (pending.size() && !openEnded && pending.back().first > endRow)
+            pending.pop_back();
+
+        if (pending.size())
+        {
+            span = pending[0];
+            pending.erase(pending.begin());
+            return true;
+        }
+
+        if (done() || (!openEnded && nextRow > endRow))
+            return false;
+
+        span.first = nextRow;
+        span.rows = blockRows;
+        span.retry = 0;
+        if (!openEnded && span.first + span.rows - 1 > endRow)
+            span.rows = endRow - span.first + 1;
+        nextRow += span.rows;
+        return true;
+    }
+
+    void addPending(uint32_t first, uint32_t rows, uint8_t retry)
+    {
+        gsheet_row_span_t span;
+        span.first = first;
+        span.rows = rows;
+        span.retry = retry;
+        size_t i = 0;
+        while (i < pending.size() && pending[i].first < first)
+            i++;
+        pending.insert(pending.begin() + i, span);
+    }
+
+    // Adjust the block size from the response time of full size block.
+    void adapt(uint32_t rows, uint32_t elapsed)
+    {
+        if (rows < GSHEET_RANGE_READER_MIN_ROWS)
+            return;
+        uint32_t n = elapsed > 0 ? (uint32_t)((uint64_t)rows * GSHEET_RANGE_READER_TARGET_MS / elapsed) : rows * 2;
+        n = n > rows * 2 ? rows * 2 : (n < rows / 2 ? rows / 2 : n);
+        blockRows = n > GSHEET_RANGE_READER_MAX_ROWS ? GSHEET_RANGE_READER_MAX_ROWS : (n < GSHEET_RANGE_READER_MIN_ROWS ? GSHEET_RANGE_READER_MIN_ROWS : n);
+    }
+
+    // The timeout, network, rate limit and server errors are retried, the other errors are not.
+    bool transient(int code)
+    {
+        if (code < 0)
+            return code >= GSHEET_ERROR_TCP_DISCONNECTED || code == GSHEET_ERROR_NETWORK_DISCONNECTED;
+        return code == GSHEET_ERROR_HTTP_CODE_REQUEST_TIMEOUT || code == GSHEET_ERROR_HTTP_CODE_TOO_MANY_REQUESTS || code >= GSHEET_ERROR_HTTP_CODE_INTERNAL_SERVER_ERROR;
+    }
+
+    // The read of range without end row walked past the last row of sheet e.g.
+    // "Range ('Sheet1'!A1001:F1100) exceeds grid limits. Max rows: 1000, max columns: 26".
+    // Returns true if the error was handled as the end of data.
+    bool gridEnd(gsheet_range_conn_t &c, int code)
+    {
+        if (!gridEnded || code != GSHEET_ERROR_HTTP_CODE_BAD_REQUEST)
+            return false;
+
+        String msg = c.result.error().message();
+        if (msg.indexOf(FPSTR("exceeds grid limits")) < 0)
+            return false;
+
+        // The end row is taken from the number of rows of sheet.
+        int p = msg.indexOf(FPSTR("Max rows: "));
+        uint32_t maxRows = p > -1 ? strtoul(msg.c_str() + p + 10, nullptr, 10) : 0;
+        if (openEnded && maxRows > 0)
+        {
+            openEnded = false;
+            endRow = maxRows;
+        }
+
+        if (!openEnded && c.first <= endRow)
+            dispatch(c, c.first, endRow - c.first + 1, c.retry);
+        else
+        {
+            // The block past the last row is emitted as the block without rows.
+            c.result.clear();
+            c.state = conn_ready;
+        }
+        return true;
+    }
+
+    void poll(gsheet_range_conn_t &c)
+    {
+        if (c.result.isError())
+        {
+            int code = c.result.error().code();
+            if (gridEnd(c, code))
+                return;
+
+            if (c.retry >= GSHEET_RANGE_READER_MAX_RETRY || !transient(code))
+            {
+                err = c.result.error();
+                c.state = conn_idle;
+                ended = true;
+                return;
+            }
+            blockRows = blockRows / 2 < GSHEET_RANGE_READER_MIN_ROWS ? GSHEET_RANGE_READER_MIN_ROWS : blockRows / 2;
+            uint32_t half = c.rows > 1 ? c.rows / 2 : 1;
+            if (c.rows > half)
+                addPending(c.first + half, c.rows - half, c.retry + 1);
+            dispatch(c, c.first, half, c.retry + 1);
+        }
+        else if (c.result.available())
+        {
+            adapt(c.rows, millis() - c.ms);
+            c.state = conn_ready;
+        }
+    }
+
+    // Find the values array of ValueRange and pass each row array to the callback or output.
+    uint32_t emit(gsheet_range_conn_t &c)
+    {
+        GSheetStringUtil sut;
+        const char *json = c.result.c_str();
+        size_t len = strlen(json);
+        const char *names[] = {"values"};
+        gsheet_json_span_t arr, row;
+        uint32_t index = 0;
+        if (!sut.scanJson(json, len, names, 1, &arr) || json[arr.start] != '[')
+            return 0;
+
+        size_t pos = arr.start + 1;
+        while (sut.nextJsonElement(json, len, pos, row))
+            onRow(c.first + index++, json + row.start, row.length());
+        return index;
+    }
+
+    void onRow(uint32_t row, const char *data, size_t len)
+    {
+        rowCount++;
+        if (cb)
+            return cb(row, data, len);
+
+        // The empty rows are omitted from response, keep the row position in the assembled array.
+        while (lastRow + 1 < row)
+        {
+            out += out.length() > 1 ? ",[]" : "[]";
+            lastRow++;
+        }
+
+        if (out.length() > 1)
+            out += ',';
+        out.concat(data, len);
+        lastRow = row;
+    }
+
+    void flush()
+    {
+        for (;;)
+        {
+            gsheet_range_conn_t *c = nullptr;
+            for (size_t i = 0; i < connCount && !c; i++)
+            {
+                if (conn[i].state == conn_ready && conn[i].first == nextEmit)
+                    c = &conn[i];
+            }
+
+            if (!c || done())
+                return;
+
+            uint32_t rows = emit(*c);
+            nextEmit += c->rows;
+            if (openEnded && rows == 0)
+                ended = true;
+            c->result.clear();
+            c->state = conn_idle;
+        }
+    }
+
+public:
+    GSheetRangeReader() {}
+    ~GSheetRangeReader() { stop(); }
+
+    /**
+     * Start reading the range.
+     *
+     * @param values The Values object that used to get the row blocks.
+     * @param clients The array of async clients, each client should use its own network client (connection).
+     * @param count The number of async clients in array (up to GSHEET_RANGE_READER_MAX_CONNECTIONS).
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param range The A1 notation of the range e.g. Sheet1!A1:F200000.
+     * @param cb The GSheetRowCallback function that receives the rows in order.
+     * When the callback is not set, the rows are assembled as JSON array and returned from c_str().
+     * @return bool Returns true if the range is valid and the reading was started.
+     */
+    bool begin(Values &values, GSheetAsyncClientClass **clients, size_t count, const GSHEET::Parent &parent, const String &range, GSheetRowCallback cb = NULL)
+    {
+        stop();
+        this->values = &values;
+        this->parent = parent;
+        this->cb = cb;
+        connCount = count > GSHEET_RANGE_READER_MAX_CONNECTIONS ? GSHEET_RANGE_READER_MAX_CONNECTIONS : count;
+        for (size_t i = 0; i < connCount; i++)
+            conn[i].client = clients[i];
+        pending.clear();
+        err.reset();
+        out = cb ? "" : "[";
+        blockRows = GSHEET_RANGE_READER_MIN_ROWS;
+        rowCount = 0;
+        ended = false;
+        if (connCount == 0 || !parseRange(range))
+            return false;
+        nextEmit = nextRow;
+        lastRow = nextRow - 1;
+        active = true;
+        return true;
+    }
+
+    /**
+     * Perform the read task repeatedly.
+     * Should be places in main loop function.
+     */
+    void loop()
+    {
+        if (!active)
+            return;
+
+        for (size_t i = 0; i < connCount; i++)
+        {
+            if (conn[i].state == conn_busy)
+                poll(conn[i]);
+        }
+
+        flush();
+
+        bool busy = false;
+        gsheet_row_span_t span;
+        for (size_t i = 0; i < connCount; i++)
+        {
+            if (conn[i].state == conn_idle && !done() && nextBlock(span))
+                dispatch(conn[i], span.first, span.rows, span.retry);
+            busy |= conn[i].state == conn_busy;
+        }
+
+        values->loop();
+
+        if (done() && !busy)
+        {
+            if (!cb)
+                out += ']';
+            active = false;
+        }
+    }
+
+    /**
+     * Cancel the reading, the tasks of async clients are stopped.
+     */
+    void stop()
+    {
+        for (size_t i = 0; i < connCount; i++)
+        {
+            if (conn[i].state == conn_busy)
+                conn[i].client->stopAsync(true);
+            conn[i].result.clear();
+            conn[i].state = conn_idle;
+        }
+        active = false;
+    }
+
+    /**
+     * Check whether the reading is in progress.
+     * @return bool Returns true if reading is in progress.
+     */
+    bool running() const { return active; }
+
+    /**
+     * Check whether the reading was aborted by the error.
+     * @return bool Returns true if the error occurred.
+     */
+    bool isError() { return err.isError(); }
+
+    /**
+     * Get the error of the request that was failed after all retries.
+     * @return GSheetError The reference of error.
+     */
+    GSheetError &error() { return err; }
+
+    /**
+     * Get the number of rows received.
+     * @return uint32_t The number of rows.
+     */
+    uint32_t rows() const { return rowCount; }
+
+    /**
+     * Get the assembled rows JSON array when the row callback was not set.
+     * @return const char * The pointer to JSON array string.
+     */
+    const char *c_str() const { return out.c_str(); }
+};
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2026 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GSHEET_READ_COALESCER_H
+#define GSHEET_READ_COALESCER_H
+
+#include <Arduino.h>
+#include "./spreadsheets/Values.h"
+#include "./core/AsyncResult/ResultFanout.h"
+
+// The time in milliseconds that the first queued read waits for the other reads.
+#if !defined(GSHEET_READ_COALESCE_WINDOW_MS)
+#define GSHEET_READ_COALESCE_WINDOW_MS 50
+#endif
+
+// The maximum number of ranges in one values:batchGet request.
+#if !defined(GSHEET_READ_COALESCE_MAX_BATCH)
+#define GSHEET_READ_COALESCE_MAX_BATCH 20
+#endif
+
+/**
+ * Merge the values.get calls of the same spreadsheet into values:batchGet.
+ *
+ * The reads of the same range that are queued or in flight share one request and one result,
+ * the distinct ranges that are queued within the window are sent as one batchGet.
+ * Each reader receives its own item of valueRanges (ValueRange) through its async result or callback.
+ */
+class GSheetReadCoalescer
+{
+private:
+    struct gsheet_read_item_t
+    {
+        String range;
+        String key;
+        std::vector<gsheet_result_owner_t> owners;
+    };
+
+    Values *values = nullptr;
+    GSheetAsyncClientClass *aClient = nullptr;
+    GSHEET::Parent parent;
+    GSHEET::BatchGetOptions options;
+    GSheetAsyncResult result;
+    GSheetResultFanout fanout;
+    std::vector<gsheet_read_item_t> queue, inflight;
+    uint32_t windowMs = GSHEET_READ_COALESCE_WINDOW_MS, ms = 0;
+    size_t maxBatch = GSHEET_READ_COALESCE_MAX_BATCH;
+    bool busy = false;
+
+    bool attach(std::vector<gsheet_read_item_t> &items, const String &key, const gsheet_result_owner_t &owner)
+    {
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            if (items[i].key == key)
+            {
+                items[i].owners.push_back(owner);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void enqueue(const String &range, GSheetAsyncResult *aResult, GSheetAsyncResultCallback cb)
+    {
+        GSheetStringUtil sut;
+        gsheet_result_owner_t owner(aResult, cb);
+
+        if (aResult)
+            aResult->clear();
+
+        String key = sut.normalizeA1(range);
+        if (attach(inflight, key, owner) || attach(queue, key, owner))
+            return;
+
+        if (queue.size() == 0)
+            ms = millis();
+
+        gsheet_read_item_t item;
+        item.range = range;
+        item.key = key;
+        item.owners.push_back(owner);
+        queue.push_back(item);
+    }
+
+    void send()
+    {
+        size_t n = queue.size() > maxBatch ? maxBatch : queue.size();
+        inflight.assign(queue.begin(), queue.begin() + n);
+        queue.erase(queue.begin(), queue.begin() + n);
+
+        GSHEET::BatchGetOptions opt = options;
+        for (size_t i = 0; i < inflight.size(); i++)
+            opt.ranges(inflight[i].range);
+
+        busy = true;
+        result.clear();
+        values->batchGet(*aClient, parent, opt, result);
+    }
+
+    // Pass the item of valueRanges array to the readers of each range.
+    void fanOut(bool failed)
+    {
+        GSheetStringUtil sut;
+        String message;
+        int code = fanout.takeError(result, failed, message);
+        const char *json = result.c_str();
+        size_t len = strlen(json);
+        const char *names[] = {"valueRanges"};
+        gsheet_json_span_t arr, item;
+        size_t pos = len;
+        if (sut.scanJson(json, len, names, 1, &arr) && json[arr.start] == '[')
+            pos = arr.start + 1;
+
+        // The items are moved out first as the callbacks may queue the new reads.
+        std::vector<gsheet_read_item_t> items;
+        items.swap(inflight);
+
+        String payload;
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            payload.remove(0, payload.length());
+            if (!failed && sut.nextJsonElement(json, len, pos, item))
+                sut.spanStr(json, item, payload);
+            for (size_t j = 0; j < items[i].owners.size(); j++)
+                fanout.deliver(items[i].owners[j], payload, code, message);
+        }
+    }
+
+public:
+    GSheetReadCoalescer() {}
+
+    /**
+     * Set the source spreadsheet of the coalescer.
+     *
+     * @param values The Values object that used to send the batchGet.
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param options The GSHEET::BatchGetOptions object included majorDimension, valueRenderOption and dateTimeRenderOption
+     * that applied to all reads, the ranges are added by the coalescer.
+     */
+    void begin(Values &values, GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const GSHEET::BatchGetOptions &options = GSHEET::BatchGetOptions())
+    {
+        this->values = &values;
+        this->aClient = &aClient;
+        this->parent = parent;
+        this->options = options;
+    }
+
+    /**
+     * Set the coalescing window.
+     *
+     * @param windowMs The time in milliseconds that the first queued read waits for the other reads.
+     * @param maxBatch The maximum number of ranges in one request, the batch is sent immediately when it is full.
+     */
+    void setWindow(uint32_t windowMs, size_t maxBatch = GSHEET_READ_COALESCE_MAX_BATCH)
+    {
+        this->windowMs = windowMs;
+        this->maxBatch = maxBatch > 0 ? maxBatch : 1;
+    }
+
+    /** Queue the read of a range.
+     *
+     * @param range The A1 notation of the range to retrieve values from.
+     * @param aResult The async result (GSheetAsyncResult) that receives the ValueRange of the range.
+     */
+    void get(const String &range, GSheetAsyncResult &aResult) { enqueue(range, &aResult, NULL); }
+
+    /** Queue the read of a range.
+     *
+     * @param range The A1 notation of the range to retrieve values from.
+     * @param cb The async result callback (GSheetAsyncResultCallback) that receives the ValueRange of the range.
+     */
+    void get(const String &range, GSheetAsyncResultCallback cb) { enqueue(range, nullptr, cb); }
+
+    /**
+     * Send the queued reads without waiting for the window.
+     */
+    void flush()
+    {
+        if (!busy && queue.size() && values)
+            send();
+    }
+
+    /**
+     * Perform the coalescing task repeatedly.
+     * Should be places in main loop function.
+     */
+    void loop()
+    {
+        if (!values)
+            return;
+
+        if (busy)
+        {
+            bool failed = result.isError();
+            if (failed || result.available())
+            {
+                busy = false;
+                fanOut(failed);
+            }
+        }
+
+        if (!busy && queue.size() && (queue.size() >= maxBatch || millis() - ms >= windowMs))
+            send();
+
+        values->loop();
+    }
+
+    /**
+     * Get the number of queued ranges that were not sent.
+     * @return size_t The number of ranges.
+     */
+    size_t size() const { return queue.size(); }
+};
+
+#endif
@@ -0,0 +1,497 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2026 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GSHEET_STRUCTURE_CACHE_H
+#define GSHEET_STRUCTURE_CACHE_H
+
+#include <Arduino.h>
+#include "./spreadsheets/GSheetBase.h"
+#include "./core/AsyncResult/ResultFanout.h"
+
+// The sheet properties that kept in GSheetStructureCache.
+struct gsheet_sheet_info_t
+{
+    String title;
+    int sheetId = -1;
+    int index = 0;
+    uint32_t rowCount = 0, columnCount = 0, frozenRowCount = 0, frozenColumnCount = 0;
+};
+
+// The info is nullptr when the sheet was not found or the properties could not be loaded.
+typedef void (*GSheetSheetInfoCallback)(const gsheet_sheet_info_t *info);
+
+/**
+ * The cache of the sheet Ids, titles and grid properties of a spreadsheet.
+ *
+ * The properties are loaded with one spreadsheets.get request (fields=sheets.properties) when they are
+ * first needed or after they become stale. The batchUpdate requests that are sent through the cache
+ * update the properties locally from their replies (addSheet, duplicateSheet, deleteSheet, appendDimension,
+ * insertDimension and deleteDimension), the other structural requests and the errors that refer to
+ * the unknown sheets or grids mark the cache as stale.
+ */
+class GSheetStructureCache
+{
+private:
+    struct gsheet_sheet_waiter_t
+    {
+        String title;
+        int sheetId = -1;
+        GSheetSheetInfoCallback cb = NULL;
+    };
+
+    struct gsheet_structure_write_t
+    {
+        gsheet_result_owner_t owner;
+        std::vector<String> requests;
+        GSheetAsyncResult result;
+    };
+
+    GSheetBase *sheets = nullptr;
+    GSheetAsyncClientClass *aClient = nullptr;
+    GSHEET::Parent parent;
+    std::vector<gsheet_sheet_info_t> list;
+    std::vector<gsheet_sheet_waiter_t> waiters;
+    std::vector<gsheet_structure_write_t *> writes;
+    GSheetAsyncResult result;
+    GSheetResultFanout fanout;
+    bool stale = true, busy = false, changed = false;
+
+    int toInt(const char *json, const gsheet_json_span_t &span, int defaultValue = 0) { return span.found() ? atoi(json + span.start) : defaultValue; }
+
+    // Copy the JSON string value with the simple escapes removed.
+    void toStr(const char *json, const gsheet_json_span_t &span, String &dest)
+    {
+        dest.remove(0, dest.length());
+        if (!span.found())
+            return;
+        dest.reserve(span.length());
+        for (int i = span.start; i < span.end; i++)
+        {
+            if (json[i] == '\\' && i + 1 < span.end && json[i + 1] != 'u')
+            {
+                i++;
+                dest += json[i] == 'n' ? '\n' : json[i] == 't' ? '\t'
+                                                                 : json[i];
+            }
+            else
+                dest += json[i];
+        }
+    }
+
+    bool parseProperties(const char *json, size_t len, gsheet_sheet_info_t &info)
+    {
+        GSheetStringUtil sut;
+        const char *names[] = {"sheetId", "title", "index", "rowCount", "columnCount", "frozenRowCount", "frozenColumnCount"};
+        gsheet_json_span_t spans[7];
+        if (!sut.scanJson(json, len, names, 7, spans) || !spans[1].found())
+            return false;
+        info.sheetId = toInt(json, spans[0]);
+        toStr(json, spans[1], info.title);
+        info.index = toInt(json, spans[2]);
+        info.rowCount = toInt(json, spans[3]);
+        info.columnCount = toInt(json, spans[4]);
+        info.frozenRowCount = toInt(json, spans[5]);
+        info.frozenColumnCount = toInt(json, spans[6]);
+        return true;
+    }
+
+    int indexOf(int sheetId)
+    {
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            if (list[i].sheetId == sheetId)
+                return i;
+        }
+        return -1;
+    }
+
+    int indexOf(const String &title)
+    {
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            if (list[i].title == title)
+                return i;
+        }
+        return -1;
+    }
+
+    void addSheet(const gsheet_sheet_info_t &info)
+    {
+        removeSheet(info.sheetId);
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            if (list[i].index >= info.index)
+                list[i].index++;
+        }
+        list.push_back(info);
+    }
+
+    void removeSheet(int sheetId)
+    {
+        int i = indexOf(sheetId);
+        if (i < 0)
+            return;
+        int index = list[i].index;
+        list.erase(list.begin() + i);
+        for (size_t k = 0; k < list.size(); k++)
+        {
+            if (list[k].index > index)
+                list[k].index--;
+        }
+    }
+
+    void resize(const char *json, size_t len, int sign, bool append)
+    {
+        GSheetStringUtil sut;
+        const char *names[] = {"sheetId", "dimension", "length", "startIndex", "endIndex"};
+        gsheet_json_span_t spans[5];
+        sut.scanJson(json, len, names, 5, spans);
+        int i = indexOf(toInt(json, spans[0]));
+        if (i < 0 || !spans[1].found())
+        {
+            stale = true;
+            return;
+        }
+        int count = append ? toInt(json, spans[2]) : toInt(json, spans[4]) - toInt(json, spans[3]);
+        uint32_t &size = json[spans[1].start] == 'R' ? list[i].rowCount : list[i].columnCount;
+        size = sign < 0 && (uint32_t)count > size ? 0 : size + sign * count;
+    }
+
+    // Apply the batchUpdate requests and their replies to the cached properties.
+    void apply(gsheet_structure_write_t &w)
+    {
+        GSheetStringUtil sut;
+        const char *json = w.result.c_str();
+        size_t len = strlen(json);
+        const char *names[] = {"replies"};
+        gsheet_json_span_t arr, item;
+        size_t pos = 0;
+        bool hasReplies = sut.scanJson(json, len, names, 1, &arr) && json[arr.start] == '[';
+        if (hasReplies)
+            pos = arr.start + 1;
+
+        for (size_t i = 0; i < w.requests.size(); i++)
+        {
+            bool hasItem = hasReplies && sut.nextJsonElement(json, len, pos, item);
+            const String &req = w.requests[i];
+            const char *r = req.c_str();
+            if (req.indexOf(FPSTR("\"addSheet\"")) == 1 || req.indexOf(FPSTR("\"duplicateSheet\"")) == 1)
+            {
+                gsheet_sheet_info_t info;
+                if (hasItem && parseProperties(json + item.start, item.length(), info))
+                    addSheet(info);
+                else
+                    stale = true;
+            }
+            else if (req.indexOf(FPSTR("\"deleteSheet\"")) == 1)
+            {
+                const char *id[] = {"sheetId"};
+                gsheet_json_span_t span;
+                if (sut.scanJson(r, req.length(), id, 1, &span))
+                    removeSheet(toInt(r, span));
+            }
+            else if (req.indexOf(FPSTR("\"appendDimension\"")) == 1)
+                resize(r, req.length(), 1, true);
+            else if (req.indexOf(FPSTR("\"insertDimension\"")) == 1)
+                resize(r, req.length(), 1, false);
+            else if (req.indexOf(FPSTR("\"deleteDimension\"")) == 1)
+                resize(r, req.length(), -1, false);
+            else if (req.indexOf(FPSTR("\"updateSheetProperties\"")) == 1 || req.indexOf(FPSTR("\"insertRange\"")) == 1 || req.indexOf(FPSTR("\"deleteRange\"")) == 1)
+                stale = true;
+        }
+    }
+
+    void parseSheets()
+    {
+        GSheetStringUtil sut;
+        const char *json = result.c_str();
+        size_t len = strlen(json);
+        const char *names[] = {"sheets"};
+        gsheet_json_span_t arr, item;
+        list.clear();
+        if (sut.scanJson(json, len, names, 1, &arr) && json[arr.start] == '[')
+        {
+            size_t pos = arr.start + 1;
+            while (sut.nextJsonElement(json, len, pos, item))
+            {
+                gsheet_sheet_info_t info;
+                if (parseProperties(json + item.start, item.length(), info))
+                    list.push_back(info);
+            }
+        }
+    }
+
+    void resolve(bool failed)
+    {
+        std::vector<gsheet_sheet_waiter_t> pending;
+        pending.swap(waiters);
+        for (size_t i = 0; i < pending.size(); i++)
+        {
+            const gsheet_sheet_info_t *info = failed ? nullptr : pending[i].title.length() ? find(pending[i].title)
+                                                                                            : findById(pending[i].sheetId);
+            if (pending[i].cb)
+                pending[i].cb(info);
+        }
+    }
+
+    void lookupImpl(const String &title, int sheetId, GSheetSheetInfoCallback cb)
+    {
+        if (!stale)
+        {
+            if (cb)
+                cb(title.length() ? find(title) : findById(sheetId));
+            return;
+        }
+        gsheet_sheet_waiter_t waiter;
+        waiter.title = title;
+        waiter.sheetId = sheetId;
+        waiter.cb = cb;
+        waiters.push_back(waiter);
+        refresh();
+    }
+
+    void batchUpdateImpl(const GSHEET::BatchUpdateOptions &options, GSheetAsyncResult *aResult, GSheetAsyncResultCallback cb)
+    {
+        GSheetStringUtil sut;
+        gsheet_structure_write_t *w = new gsheet_structure_write_t();
+        w->owner = gsheet_result_owner_t(aResult, cb);
+        if (aResult)
+            aResult->clear();
+
+        // Keep the requests to match their replies, the replies of deleteSheet and dimension requests are empty.
+        const char *json = options.c_str();
+        size_t len = strlen(json);
+        const char *names[] = {"requests"};
+        gsheet_json_span_t arr, item;
+        if (sut.scanJson(json, len, names, 1, &arr) && json[arr.start] == '[')
+        {
+            size_t pos = arr.start + 1;
+            String req;
+            while (sut.nextJsonElement(json, len, pos, item))
+            {
+                sut.spanStr(json, item, req);
+                w->requests.push_back(req);
+            }
+        }
+        writes.push_back(w);
+        sheets->batchUpdate(*aClient, parent, options, w->result);
+    }
+
+public:
+    GSheetStructureCache() {}
+    ~GSheetStructureCache()
+    {
+        for (size_t i = 0; i < writes.size(); i++)
+            delete writes[i];
+    }
+
+    /**
+     * Set the service object, async client and spreadsheet of the cache.
+     *
+     * @param sheets The service object (GSheetBase) e.g. Values or Sheets that used to send the requests.
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     */
+    void begin(GSheetBase &sheets, GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent)
+    {
+        this->sheets = &sheets;
+        this->aClient = &aClient;
+        this->parent = parent;
+        list.clear();
+        stale = true;
+    }
+
+    /**
+     * Load the sheet properties from the spreadsheet.
+     * The request is not sent when the previous refresh is in progress.
+     */
+    void refresh()
+    {
+        if (!sheets || busy)
+            return;
+        busy = true;
+        changed = false;
+        GSHEET::GetOptions options;
+        options.fields(GSHEET::SpreadsheetFields().sheets(GSHEET::SheetFields().properties(GSHEET::SheetPropertiesFields().sheetId().title().index().gridProperties())));
+        sheets->get(*aClient, parent, options, result);
+    }
+
+    /**
+     * Mark the cache as stale, the properties are loaded again when they are needed.
+     */
+    void invalidate() { stale = true; }
+
+    /**
+     * Report the error of request that used the cached properties.
+     * The cache is marked as stale when the error refers to the unknown sheet, grid or range.
+     *
+     * @param code The error code.
+     * @param message The error message.
+     */
+    void reportError(int code, const String &message)
+    {
+        if (code == GSHEET_ERROR_HTTP_CODE_BAD_REQUEST && (message.indexOf(FPSTR("grid")) > -1 || message.indexOf(FPSTR("sheet")) > -1 || message.indexOf(FPSTR("parse range")) > -1))
+            stale = true;
+    }
+
+    /**
+     * Get the cached properties of the sheet.
+     * The properties are loaded when the cache is stale and nullptr is returned until they are ready.
+     *
+     * @param title The sheet title.
+     * @return const gsheet_sheet_info_t * The sheet properties or nullptr.
+     */
+    const gsheet_sheet_info_t *find(const String &title)
+    {
+        if (stale)
+        {
+            refresh();
+            return nullptr;
+        }
+        int i = indexOf(title);
+        return i > -1 ? &list[i] : nullptr;
+    }
+
+    /**
+     * Get the cached properties of the sheet.
+     * The properties are loaded when the cache is stale and nullptr is returned until they are ready.
+     *
+     * @param sheetId The sheet Id.
+     * @return const gsheet_sheet_info_t * The sheet properties or nullptr.
+     */
+    const gsheet_sheet_info_t *findById(int sheetId)
+    {
+        if (stale)
+        {
+            refresh();
+            return nullptr;
+        }
+        int i = indexOf(sheetId);
+        return i > -1 ? &list[i] : nullptr;
+    }
+
+    /**
+     * Get the properties of the sheet, the callback is called when the properties are ready.
+     *
+     * @param title The sheet title.
+     * @param cb The GSheetSheetInfoCallback function.
+     */
+    void lookup(const String &title, GSheetSheetInfoCallback cb) { lookupImpl(title, -1, cb); }
+
+    /**
+     * Get the properties of the sheet, the callback is called when the properties are ready.
+     *
+     * @param sheetId The sheet Id.
+     * @param cb The GSheetSheetInfoCallback function.
+     */
+    void lookup(int sheetId, GSheetSheetInfoCallback cb) { lookupImpl("", sheetId, cb); }
+
+    /** Applies one or more updates to the spreadsheet and keeps the cached properties up to date.
+     * The parameters are the same as GSheetBase::batchUpdate.
+     */
+    void batchUpdate(const GSHEET::BatchUpdateOptions &options, GSheetAsyncResult &aResult) { batchUpdateImpl(options, &aResult, NULL); }
+
+    /** Applies one or more updates to the spreadsheet and keeps the cached properties up to date.
+     * The parameters are the same as GSheetBase::batchUpdate.
+     */
+    void batchUpdate(const GSHEET::BatchUpdateOptions &options, GSheetAsyncResultCallback cb) { batchUpdateImpl(options, nullptr, cb); }
+
+    /**
+     * Perform the cache tasks repeatedly.
+     * Should be places in main loop function.
+     */
+    void loop()
+    {
+        if (!sheets)
+            return;
+
+        if (busy)
+        {
+            bool failed = result.isError();
+            if (failed || result.available())
+            {
+                busy = false;
+                if (!failed)
+                {
+                    parseSheets();
+                    // The structure was changed while loading, the loaded properties may be older.
+                    stale = changed;
+                }
+                if (!failed && stale)
+                    refresh();
+                else
+                    resolve(failed);
+            }
+        }
+
+        for (size_t i = 0; i < writes.size();)
+        {
+            gsheet_structure_write_t *w = writes[i];
+            bool failed = w->result.isError();
+            if (!failed && !w->result.available())
+            {
+                i++;
+                continue;
+            }
+
+            String message;
+            int code = fanout.takeError(w->result, failed, message);
+
+            if (failed)
+                reportError(code, message);
+            else if (!stale)
+                apply(*w);
+            if (busy)
+                changed = true;
+
+            writes.erase(writes.begin() + i);
+            fanout.deliver(w->owner, w->result.payload(), code, message);
+            delete w;
+        }
+
+        sheets->loop();
+    }
+
+    /**
+     * Check whether the cached properties are loaded and not stale.
+     * @return bool The cache status.
+     */
+    bool ready() const { return !stale; }
+
+    /**
+     * Get the number of cached sheets.
+     * @return size_t The number of sheets.
+     */
+    size_t size() const { return list.size(); }
+
+    /**
+     * Get the cached sheet properties at the position in the cache (not the sheet index).
+     * @param i The position in the cache.
+     * @return const gsheet_sheet_info_t & The sheet properties.
+     */
+    const gsheet_sheet_info_t &operator[](size_t i) const { return list[i]; }
+};
+
+#endif
@@ -0,0 +1,240 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2026 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GSHEET_UPDATE_COALESCER_H
+#define GSHEET_UPDATE_COALESCER_H
+
+#include <Arduino.h>
+#include "./spreadsheets/Values.h"
+#include "./core/AsyncResult/ResultFanout.h"
+
+// The time in milliseconds that the first queued update waits for the other updates.
+#if !defined(GSHEET_UPDATE_COALESCE_WINDOW_MS)
+#define GSHEET_UPDATE_COALESCE_WINDOW_MS 200
+#endif
+
+// The maximum number of ranges in one values:batchUpdate request.
+#if !defined(GSHEET_UPDATE_COALESCE_MAX_BATCH)
+#define GSHEET_UPDATE_COALESCE_MAX_BATCH 20
+#endif
+
+/**
+ * Hold the small values.update calls for a short window and send them as one values:batchUpdate.
+ *
+ * The updates of the same range are merged (last writer wins) and the updates of the different ranges
+ * are sent in the order they were queued, the later update wins where the ranges overlap.
+ * Each update owner receives its own item of the batchUpdate responses through its async result or callback.
+ */
+class GSheetUpdateCoalescer
+{
+private:
+    struct gsheet_update_item_t
+    {
+        String range;
+        String key;
+        String values;
+        std::vector<gsheet_result_owner_t> owners;
+    };
+
+    Values *values = nullptr;
+    GSheetAsyncClientClass *aClient = nullptr;
+    GSHEET::Parent parent;
+    GSHEET::ValueInputOption input = GSHEET::USER_ENTERED;
+    GSheetAsyncResult result;
+    GSheetResultFanout fanout;
+    std::vector<gsheet_update_item_t> queue, inflight;
+    uint32_t windowMs = GSHEET_UPDATE_COALESCE_WINDOW_MS, ms = 0;
+    size_t maxBatch = GSHEET_UPDATE_COALESCE_MAX_BATCH;
+    bool busy = false;
+
+    void enqueue(const String &range, const gsheet_object_t &data, GSheetAsyncResult *aResult, GSheetAsyncResultCallback cb)
+    {
+        gsheet_result_owner_t owner(aResult, cb);
+
+        if (aResult)
+            aResult->clear();
+
+        GSheetStringUtil sut;
+        String key = sut.normalizeA1(range);
+        for (size_t i = 0; i < queue.size(); i++)
+        {
+            if (queue[i].key == key)
+            {
+                // The merged update is moved to the back, so it is applied after the overlapping updates queued before it.
+                gsheet_update_item_t item = queue[i];
+                queue.erase(queue.begin() + i);
+                item.values = data.c_str();
+                item.owners.push_back(owner);
+                queue.push_back(item);
+                return;
+            }
+        }
+
+        if (queue.size() == 0)
+            ms = millis();
+
+        gsheet_update_item_t item;
+        item.range = range;
+        item.key = key;
+        item.values = data.c_str();
+        item.owners.push_back(owner);
+        queue.push_back(item);
+    }
+
+    void send()
+    {
+        size_t n = queue.size() > maxBatch ? maxBatch : queue.size();
+        inflight.assign(queue.begin(), queue.begin() + n);
+        queue.erase(queue.begin(), queue.begin() + n);
+
+        GSHEET::BatchUpdateValuesOptions options;
+        options.valueInputOption(input);
+        for (size_t i = 0; i < inflight.size(); i++)
+        {
+            GSHEET::ValueRange valueRange;
+            valueRange.range(inflight[i].range).values(gsheet_object_t(inflight[i].values));
+            options.data(valueRange);
+        }
+
+        busy = true;
+        result.clear();
+        values->batchUpdate(*aClient, parent, options, result);
+    }
+
+    // Pass the item of responses array to the owners of each update.
+    void fanOut(bool failed)
+    {
+        GSheetStringUtil sut;
+        String message;
+        int code = fanout.takeError(result, failed, message);
+        const char *json = result.c_str();
+        size_t len = strlen(json);
+        const char *names[] = {"responses"};
+        gsheet_json_span_t arr, item;
+        size_t pos = len;
+        if (sut.scanJson(json, len, names, 1, &arr) && json[arr.start] == '[')
+            pos = arr.start + 1;
+
+        String payload;
+        for (size_t i = 0; i < inflight.size(); i++)
+        {
+            payload.remove(0, payload.length());
+            if (!failed && sut.nextJsonElement(json, len, pos, item))
+                sut.spanStr(json, item, payload);
+            for (size_t j = 0; j < inflight[i].owners.size(); j++)
+                fanout.deliver(inflight[i].owners[j], payload, code, message);
+        }
+        inflight.clear();
+    }
+
+public:
+    GSheetUpdateCoalescer() {}
+
+    /**
+     * Set the target spreadsheet of the coalescer.
+     *
+     * @param values The Values object that used to send the batchUpdate.
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param input How the input data should be interpreted, GSHEET::RAW or GSHEET::USER_ENTERED.
+     */
+    void begin(Values &values, GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, GSHEET::ValueInputOption input = GSHEET::USER_ENTERED)
+    {
+        this->values = &values;
+        this->aClient = &aClient;
+        this->parent = parent;
+        this->input = input;
+    }
+
+    /**
+     * Set the coalescing window.
+     *
+     * @param windowMs The time in milliseconds that the first queued update waits for the other updates.
+     * @param maxBatch The maximum number of ranges in one request, the batch is sent immediately when it is full.
+     */
+    void setWindow(uint32_t windowMs, size_t maxBatch = GSHEET_UPDATE_COALESCE_MAX_BATCH)
+    {
+        this->windowMs = windowMs;
+        this->maxBatch = maxBatch > 0 ? maxBatch : 1;
+    }
+
+    /** Queue the values to set in a range.
+     *
+     * @param range The A1 notation of the values to update.
+     * @param data The values as JSON array of arrays e.g. [[1,"a"],[2,"b"]].
+     * @param aResult The async result (GSheetAsyncResult) that receives the item of batchUpdate responses (UpdateValuesResponse).
+     */
+    void update(const String &range, const gsheet_object_t &data, GSheetAsyncResult &aResult) { enqueue(range, data, &aResult, NULL); }
+
+    /** Queue the values to set in a range.
+     *
+     * @param range The A1 notation of the values to update.
+     * @param data The values as JSON array of arrays e.g. [[1,"a"],[2,"b"]].
+     * @param cb The async result callback (GSheetAsyncResultCallback) that receives the item of batchUpdate responses (UpdateValuesResponse).
+     */
+    void update(const String &range, const gsheet_object_t &data, GSheetAsyncResultCallback cb) { enqueue(range, data, nullptr, cb); }
+
+    /**
+     * Send the queued updates without waiting for the window.
+     */
+    void flush()
+    {
+        if (!busy && queue.size() && values)
+            send();
+    }
+
+    /**
+     * Perform the coalescing task repeatedly.
+     * Should be places in main loop function.
+     */
+    void loop()
+    {
+        if (!values)
+            return;
+
+        if (busy)
+        {
+            bool failed = result.isError();
+            if (failed || result.available())
+            {
+                busy = false;
+                fanOut(failed);
+            }
+        }
+
+        if (!busy && queue.size() && (queue.size() >= maxBatch || millis() - ms >= windowMs))
+            send();
+
+        values->loop();
+    }
+
+    /**
+     * Get the number of queued ranges that were not sent.
+     * @return size_t The number of ranges.
+     */
+    size_t size() const { return queue.size(); }
+};
+
+#endif
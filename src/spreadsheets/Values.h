@@ -44,6 +44,11 @@ public:
      */
     void get(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const String &range, GSheetAsyncResult &aResult)
     {
+        GSheetURLUtil uut;
+        String path = spreadsheetPath(parent);
+        path += FPSTR("/values/");
+        path += uut.encode(range);
+        sendRequest(aClient, &aResult, NULL, "", path, "", gsheet_async_request_handler_t::http_get, "");
     }
 
     /** Get one or more ranges of values from a spreadsheet.
@@ -63,6 +68,9 @@ public:
      */
     void batchGet(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const GSHEET::BatchGetOptions &options, GSheetAsyncResult &aResult)
     {
+        String path = spreadsheetPath(parent);
+        path += FPSTR("/values:batchGet");
+        sendRequest(aClient, &aResult, NULL, "", path, options.getQueryString(), gsheet_async_request_handler_t::http_get, "");
     }
 
      /** Get one or more ranges of values from a spreadsheet.
@@ -83,6 +91,70 @@ public:
     void batchGetByDataFilter(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const GSHEET::BatchGetByDataFilterOpions &options, GSheetAsyncResult &aResult)
     {
     }
+
+    /** Appends values to a spreadsheet. The input range is used to search for existing data and find a "table" within that range.
+     * Values will be appended to the next row of the table, starting with the first column of the table.
+     *
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param range The A1 notation of a range to search for a logical table of data.
+     * @param valueRange The GSHEET::ValueRange object that represents the values to append.
+     * @param options The GSHEET::AppendOptions object included valueInputOption, insertDataOption, includeValuesInResponse, responseValueRenderOption and responseDateTimeRenderOption.
+     * The valueInputOption is required.
+     * @param aResult The async result (GSheetAsyncResult).
+     *
+     * For ref doc go to https://developers.google.com/sheets/api/reference/rest/v4/spreadsheets.values/append
+     *
+     */
+    void append(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const String &range, const GSHEET::ValueRange &valueRange, const GSHEET::AppendOptions &options, GSheetAsyncResult &aResult)
+    {
+        GSheetURLUtil uut;
+        String path = spreadsheetPath(parent);
+        path += FPSTR("/values/");
+        path += uut.encode(range);
+        path += FPSTR(":append");
+        sendRequest(aClient, &aResult, NULL, "", path, options.getQueryString(), gsheet_async_request_handler_t::http_post, valueRange.c_str());
+    }
+
+    /** Sets values in a range of a spreadsheet.
+     *
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param range The A1 notation of the values to update.
+     * @param valueRange The GSHEET::ValueRange object that represents the values to update.
+     * @param options The GSHEET::UpdateOptions object included valueInputOption, includeValuesInResponse, responseValueRenderOption and responseDateTimeRenderOption.
+     * The valueInputOption is required.
+     * @param aResult The async result (GSheetAsyncResult).
+     *
+     * For ref doc go to https://developers.google.com/sheets/api/reference/rest/v4/spreadsheets.values/update
+     *
+     */
+    void update(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const String &range, const GSHEET::ValueRange &valueRange, const GSHEET::UpdateOptions &options, GSheetAsyncResult &aResult)
+    {
+        GSheetURLUtil uut;
+        String path = spreadsheetPath(parent);
+        path += FPSTR("/values/");
+        path += uut.encode(range);
+        sendRequest(aClient, &aResult, NULL, "", path, options.getQueryString(), gsheet_async_request_handler_t::http_put, valueRange.c_str());
+    }
+
+    /** Sets values in one or more ranges of a spreadsheet.
+     *
+     * @param aClient The async client.
+     * @param parent The GSHEET::Parent object included spreadsheet Id in its constructor.
+     * @param options The GSHEET::BatchUpdateValuesOptions object included valueInputOption, data, includeValuesInResponse, responseValueRenderOption and responseDateTimeRenderOption.
+     * The valueInputOption is required.
+     * @param aResult The async result (GSheetAsyncResult).
+     *
+     * For ref doc go to https://developers.google.com/sheets/api/reference/rest/v4/spreadsheets.values/batchUpdate
+     *
+     */
+    void batchUpdate(GSheetAsyncClientClass &aClient, const GSHEET::Parent &parent, const GSHEET::BatchUpdateValuesOptions &options, GSheetAsyncResult &aResult)
+    {
+        String path = spreadsheetPath(parent);
+        path += FPSTR("/values:batchUpdate");
+        sendRequest(aClient, &aResult, NULL, "", path, "", gsheet_async_request_handler_t::http_post, options.c_str());
+    }
 };
 
 #endif
\ No newline at end of file
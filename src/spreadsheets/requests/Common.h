@@ -271,6 +271,21 @@ namespace GSHEET
         SERIAL_NUMBER,   //	Instructs date, time, datetime, and duration fields to be output as doubles in "serial number" format, as popularized by Lotus 1-2-3. The whole number portion of the value (left of the decimal) counts the days since December 30th 1899. The fractional portion (right of the decimal) counts the time as a fraction of the day. For example, January 1st 1900 at noon would be 2.5, 2 because it's 2 days after December 30th 1899, and .5 because noon is half a day. February 1st 1900 at 3pm would be 33.625. This correctly treats the year 1900 as not a leap year.
         FORMATTED_STRING //	Instructs date, time, datetime, and duration fields to be output as strings in their given number format (which depends on the spreadsheet locale).
     };
+
+    // Determines how input data should be interpreted.
+    enum ValueInputOption
+    {
+        INPUT_VALUE_OPTION_UNSPECIFIED, //	Default input value. This value must not be used.
+        RAW,                            //	The values the user has entered will not be parsed and will be stored as-is.
+        USER_ENTERED                    //	The values will be parsed as if the user typed them into the UI. Numbers will stay as numbers, but strings may be converted to numbers, dates, etc. following the same rules that are applied when entering text into a cell via the Google Sheets UI.
+    };
+
+    // Determines how existing data is changed when new data is input.
+    enum InsertDataOption
+    {
+        OVERWRITE,  //	The new data overwrites existing data in the areas it is written. (Note: adding data to the end of the sheet will still insert new rows or columns so the data can be written.)
+        INSERT_ROWS //	Rows are inserted for the new data.
+    };
 }
 
 namespace UpdateInterval
@@ -492,6 +507,10 @@ namespace GSHEET
     const struct key_str_40 _ValueRenderOption[ValueRenderOption::FORMULA + 1] PROGMEM = {"FORMATTED_VALUE", "UNFORMATTED_VALUE", "FORMULA"};
 
     const struct key_str_40 _DateTimeRenderOption[DateTimeRenderOption::FORMATTED_STRING + 1] PROGMEM = {"SERIAL_NUMBER", "FORMATTED_STRING"};
+
+    const struct key_str_40 _ValueInputOption[ValueInputOption::USER_ENTERED + 1] PROGMEM = {"INPUT_VALUE_OPTION_UNSPECIFIED", "RAW", "USER_ENTERED"};
+
+    const struct key_str_20 _InsertDataOption[InsertDataOption::INSERT_ROWS + 1] PROGMEM = {"OVERWRITE", "INSERT_ROWS"};
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,212 @@
+#ifndef FIELD_MASK_H
+#define FIELD_MASK_H
+
+#include <Arduino.h>
+#include "./Config.h"
+
+namespace GSHEET
+{
+    /**
+     * The fields expression of the partial response, e.g. sheets(properties(sheetId,title),data(rowData(values(formattedValue)))).
+     * The member without sub fields selects the whole member.
+     */
+    class FieldMask : public Printable
+    {
+    protected:
+        String buf;
+
+        // Add the member to the fields expression, the member that was already added is replaced.
+        template <typename T>
+        T &add(T &ret, const String &name, const FieldMask *sub = nullptr)
+        {
+            remove(name);
+            if (buf.length())
+                buf += ',';
+            buf += name;
+            if (sub && sub->buf.length())
+            {
+                buf += '(';
+                buf += sub->buf;
+                buf += ')';
+            }
+            return ret;
+        }
+
+        void remove(const String &name)
+        {
+            int depth = 0, p1 = 0;
+            for (int i = 0; i <= (int)buf.length(); i++)
+            {
+                if (i < (int)buf.length())
+                {
+                    if (buf[i] == '(')
+                        depth++;
+                    else if (buf[i] == ')')
+                        depth--;
+                    if (depth > 0 || buf[i] != ',')
+                        continue;
+                }
+
+                int e = buf.indexOf('(', p1);
+                if (e < 0 || e > i)
+                    e = i;
+                if (e - p1 == (int)name.length() && strncmp(buf.c_str() + p1, name.c_str(), e - p1) == 0)
+                {
+                    // Remove the member and its separator.
+                    buf.remove(p1 > 0 ? p1 - 1 : p1, i - p1 + (i < (int)buf.length() || p1 > 0 ? 1 : 0));
+                    return;
+                }
+                p1 = i + 1;
+            }
+        }
+
+    public:
+        FieldMask() {}
+        const char *c_str() const { return buf.c_str(); }
+        size_t printTo(Print &p) const { return p.print(buf.c_str()); }
+        void clear() { buf.remove(0, buf.length()); }
+    };
+
+    /**
+     * The fields of CellData.
+     */
+    class CellDataFields : public FieldMask
+    {
+    public:
+        CellDataFields() {}
+        CellDataFields &userEnteredValue() { return add(*this, FPSTR(__func__)); }
+        CellDataFields &effectiveValue() { return add(*this, FPSTR(__func__)); }
+        CellDataFields &formattedValue() { return add(*this, FPSTR(__func__)); }
+        CellDataFields &userEnteredFormat() { return add(*this, FPSTR(__func__)); }
+        CellDataFields &effectiveFormat() { return add(*this, FPSTR(__func__)); }
+        CellDataFields &hyperlink() { return add(*this, FPSTR(__func__)); }
+        CellDataFields &note() { return add(*this, FPSTR(__func__)); }
+        CellDataFields &textFormatRuns() { return add(*this, FPSTR(__func__)); }
+        CellDataFields &dataValidation() { return add(*this, FPSTR(__func__)); }
+        CellDataFields &pivotTable() { return add(*this, FPSTR(__func__)); }
+        CellDataFields &dataSourceTable() { return add(*this, FPSTR(__func__)); }
+        CellDataFields &dataSourceFormula() { return add(*this, FPSTR(__func__)); }
+    };
+
+    /**
+     * The fields of RowData.
+     */
+    class RowDataFields : public FieldMask
+    {
+    public:
+        RowDataFields() {}
+        RowDataFields &values() { return add(*this, FPSTR(__func__)); }
+        RowDataFields &values(const CellDataFields &value) { return add(*this, FPSTR(__func__), &value); }
+    };
+
+    /**
+     * The fields of GridData.
+     */
+    class GridDataFields : public FieldMask
+    {
+    public:
+        GridDataFields() {}
+        GridDataFields &startRow() { return add(*this, FPSTR(__func__)); }
+        GridDataFields &startColumn() { return add(*this, FPSTR(__func__)); }
+        GridDataFields &rowData() { return add(*this, FPSTR(__func__)); }
+        GridDataFields &rowData(const RowDataFields &value) { return add(*this, FPSTR(__func__), &value); }
+        GridDataFields &rowMetadata() { return add(*this, FPSTR(__func__)); }
+        GridDataFields &columnMetadata() { return add(*this, FPSTR(__func__)); }
+    };
+
+    /**
+     * The fields of GridProperties.
+     */
+    class GridPropertiesFields : public FieldMask
+    {
+    public:
+        GridPropertiesFields() {}
+        GridPropertiesFields &rowCount() { return add(*this, FPSTR(__func__)); }
+        GridPropertiesFields &columnCount() { return add(*this, FPSTR(__func__)); }
+        GridPropertiesFields &frozenRowCount() { return add(*this, FPSTR(__func__)); }
+        GridPropertiesFields &frozenColumnCount() { return add(*this, FPSTR(__func__)); }
+        GridPropertiesFields &hideGridlines() { return add(*this, FPSTR(__func__)); }
+        GridPropertiesFields &rowGroupControlAfter() { return add(*this, FPSTR(__func__)); }
+        GridPropertiesFields &columnGroupControlAfter() { return add(*this, FPSTR(__func__)); }
+    };
+
+    /**
+     * The fields of SheetProperties.
+     */
+    class SheetPropertiesFields : public FieldMask
+    {
+    public:
+        SheetPropertiesFields() {}
+        SheetPropertiesFields &sheetId() { return add(*this, FPSTR(__func__)); }
+        SheetPropertiesFields &title() { return add(*this, FPSTR(__func__)); }
+        SheetPropertiesFields &index() { return add(*this, FPSTR(__func__)); }
+        SheetPropertiesFields &sheetType() { return add(*this, FPSTR(__func__)); }
+        SheetPropertiesFields &gridProperties() { return add(*this, FPSTR(__func__)); }
+        SheetPropertiesFields &gridProperties(const GridPropertiesFields &value) { return add(*this, FPSTR(__func__), &value); }
+        SheetPropertiesFields &hidden() { return add(*this, FPSTR(__func__)); }
+        SheetPropertiesFields &tabColorStyle() { return add(*this, FPSTR(__func__)); }
+        SheetPropertiesFields &rightToLeft() { return add(*this, FPSTR(__func__)); }
+        SheetPropertiesFields &dataSourceSheetProperties() { return add(*this, FPSTR(__func__)); }
+    };
+
+    /**
+     * The fields of Sheet.
+     */
+    class SheetFields : public FieldMask
+    {
+    public:
+        SheetFields() {}
+        SheetFields &properties() { return add(*this, FPSTR(__func__)); }
+        SheetFields &properties(const SheetPropertiesFields &value) { return add(*this, FPSTR(__func__), &value); }
+        SheetFields &data() { return add(*this, FPSTR(__func__)); }
+        SheetFields &data(const GridDataFields &value) { return add(*this, FPSTR(__func__), &value); }
+        SheetFields &merges() { return add(*this, FPSTR(__func__)); }
+        SheetFields &conditionalFormats() { return add(*this, FPSTR(__func__)); }
+        SheetFields &filterViews() { return add(*this, FPSTR(__func__)); }
+        SheetFields &protectedRanges() { return add(*this, FPSTR(__func__)); }
+        SheetFields &basicFilter() { return add(*this, FPSTR(__func__)); }
+        SheetFields &charts() { return add(*this, FPSTR(__func__)); }
+        SheetFields &bandedRanges() { return add(*this, FPSTR(__func__)); }
+        SheetFields &developerMetadata() { return add(*this, FPSTR(__func__)); }
+        SheetFields &rowGroups() { return add(*this, FPSTR(__func__)); }
+        SheetFields &columnGroups() { return add(*this, FPSTR(__func__)); }
+        SheetFields &slicers() { return add(*this, FPSTR(__func__)); }
+    };
+
+    /**
+     * The fields of SpreadsheetProperties.
+     */
+    class SpreadsheetPropertiesFields : public FieldMask
+    {
+    public:
+        SpreadsheetPropertiesFields() {}
+        SpreadsheetPropertiesFields &title() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetPropertiesFields &locale() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetPropertiesFields &autoRecalc() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetPropertiesFields &timeZone() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetPropertiesFields &defaultFormat() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetPropertiesFields &iterativeCalculationSettings() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetPropertiesFields &spreadsheetTheme() { return add(*this, FPSTR(__func__)); }
+    };
+
+    /**
+     * The fields of Spreadsheet.
+     */
+    class SpreadsheetFields : public FieldMask
+    {
+    public:
+        SpreadsheetFields() {}
+        SpreadsheetFields &spreadsheetId() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetFields &properties() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetFields &properties(const SpreadsheetPropertiesFields &value) { return add(*this, FPSTR(__func__), &value); }
+        SpreadsheetFields &sheets() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetFields &sheets(const SheetFields &value) { return add(*this, FPSTR(__func__), &value); }
+        SpreadsheetFields &namedRanges() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetFields &spreadsheetUrl() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetFields &developerMetadata() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetFields &dataSources() { return add(*this, FPSTR(__func__)); }
+        SpreadsheetFields &dataSourceSchedules() { return add(*this, FPSTR(__func__)); }
+    };
+}
+
+#endif
@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+#
+# Created October 18, 2026
+#
+# The MIT License (MIT)
+# Copyright (c) 2026 K. Suwatchai (Mobizt)
+#
+# Generate the prebuilt BearSSL trust anchors table (C source and header) from the PEM certificate bundle.
+#
+# The table is constant data defined in the C source, it needs no constructor and stays in read-only memory.
+# It can be passed to BSSL_TCP_Client::setTrustAnchors(TAs, TAs_NUM) which uses it in place, the certificates
+# are not parsed and no memory is allocated at connect time.
+#
+# Usage: python3 gen_trust_anchors.py <bundle.pem> [output] [--name TAs]
+#
+# The output.h and output.c (trust_anchors.h and trust_anchors.c by default) are written, add both to the sketch
+# or project and include the header.
+#
+# Only RSA and EC (P-256, P-384, P-521) public keys are supported, other certificates are skipped.
+
+import base64
+import os
+import re
+import sys
+
+OID_RSA = bytes.fromhex('2a864886f70d010101')
+OID_EC = bytes.fromhex('2a8648ce3d0201')
+OID_BASIC_CONSTRAINTS = bytes.fromhex('551d13')
+EC_CURVES = {
+    bytes.fromhex('2a8648ce3d030107'): 'BR_EC_secp256r1',
+    bytes.fromhex('2b81040022'): 'BR_EC_secp384r1',
+    bytes.fromhex('2b81040023'): 'BR_EC_secp521r1',
+}
+
+
+def der_read(buf, pos):
+    """Read one DER TLV at pos, return (tag, value_start, value_end, raw_start)."""
+    start = pos
+    tag = buf[pos]
+    pos += 1
+    ln = buf[pos]
+    pos += 1
+    if ln & 0x80:
+        n = ln & 0x7f
+        ln = int.from_bytes(buf[pos:pos + n], 'big')
+        pos += n
+    return tag, pos, pos + ln, start
+
+
+def der_children(buf, start, end):
+    items = []
+    pos = start
+    while pos < end:
+        item = der_read(buf, pos)
+        items.append(item)
+        pos = item[2]
+    return items
+
+
+def parse_cert(der):
+    _, s, e, _ = der_read(der, 0)
+    tbs = der_children(der, *der_children(der, s, e)[0][1:3])
+    idx = 1 if tbs[0][0] == 0xa0 else 0  # optional version
+    # serial, signature, issuer, validity, subject, subjectPublicKeyInfo
+    subject = tbs[idx + 4]
+    spki = tbs[idx + 5]
+    dn = der[subject[3]:subject[2]]
+
+    alg, bits = der_children(der, spki[1], spki[2])
+    alg_items = der_children(der, alg[1], alg[2])
+    oid = der[alg_items[0][1]:alg_items[0][2]]
+    key = der[bits[1] + 1:bits[2]]  # skip unused bits byte
+
+    is_ca = False
+    for item in tbs[idx + 6:]:
+        if item[0] != 0xa3:
+            continue
+        exts = der_children(der, item[1], item[2])[0]
+        for ext in der_children(der, exts[1], exts[2]):
+            fields = der_children(der, ext[1], ext[2])
+            if der[fields[0][1]:fields[0][2]] != OID_BASIC_CONSTRAINTS:
+                continue
+            octets = fields[-1]
+            bc = der_read(der, octets[1])
+            for f in der_children(der, bc[1], bc[2]):
+                if f[0] == 0x01 and der[f[1]] != 0:
+                    is_ca = True
+
+    if oid == OID_RSA:
+        rsa = der_read(key, 0)
+        n, e = der_children(key, rsa[1], rsa[2])[:2]
+        return dn, is_ca, ('rsa', key[n[1]:n[2]].lstrip(b'\x00'), key[e[1]:e[2]].lstrip(b'\x00'))
+    if oid == OID_EC and len(alg_items) > 1:
+        curve = EC_CURVES.get(der[alg_items[1][1]:alg_items[1][2]])
+        if curve:
+            return dn, is_ca, ('ec', curve, key)
+    return None
+
+
+def c_array(name, data):
+    lines = ['static const unsigned char %s[] = {' % name]
+    for i in range(0, len(data), 12):
+        lines.append('    ' + ', '.join('0x%02X' % b for b in data[i:i + 12]) + ',')
+    lines.append('};')
+    return '\n'.join(lines) + '\n'
+
+
+def generate(pem, name, header):
+    blocks = re.findall(r'-----BEGIN CERTIFICATE-----(.+?)-----END CERTIFICATE-----', pem, re.S)
+    arrays, entries = [], []
+    for block in blocks:
+        try:
+            info = parse_cert(base64.b64decode(''.join(block.split())))
+        except (IndexError, ValueError):
+            info = None
+        if not info:
+            continue
+        dn, is_ca, key = info
+        i = len(entries)
+        arrays.append(c_array('%s%d_DN' % (name, i), dn))
+        flags = 'BR_X509_TA_CA' if is_ca else '0'
+        if key[0] == 'rsa':
+            arrays.append(c_array('%s%d_RSA_N' % (name, i), key[1]))
+            arrays.append(c_array('%s%d_RSA_E' % (name, i), key[2]))
+            entries.append('    {{(unsigned char *)%s%d_DN, sizeof %s%d_DN}, %s,\n'
+                           '     {.key_type = BR_KEYTYPE_RSA, .key.rsa = {(unsigned char *)%s%d_RSA_N, sizeof %s%d_RSA_N, '
+                           '(unsigned char *)%s%d_RSA_E, sizeof %s%d_RSA_E}}},'
+                           % (name, i, name, i, flags, name, i, name, i, name, i, name, i))
+        else:
+            # The ec key is not the first member of the key union, it is set by the C99 designated initializer.
+            arrays.append(c_array('%s%d_EC_Q' % (name, i), key[2]))
+            entries.append('    {{(unsigned char *)%s%d_DN, sizeof %s%d_DN}, %s,\n'
+                           '     {.key_type = BR_KEYTYPE_EC, .key.ec = {%s, (unsigned char *)%s%d_EC_Q, sizeof %s%d_EC_Q}}},'
+                           % (name, i, name, i, flags, key[1], name, i, name, i))
+
+    guard = name.upper() + '_TRUST_ANCHORS_H'
+    h = ['// Generated by tools/gen_trust_anchors.py, do not edit.\n',
+         '#ifndef %s\n#define %s\n\n' % (guard, guard),
+         '#include "client/SSLClient/bssl/bearssl.h"\n\n',
+         '#define %s_NUM %d\n\n' % (name, len(entries)),
+         '#ifdef __cplusplus\nextern "C"\n{\n#endif\n\n',
+         'extern const br_x509_trust_anchor %s[%s_NUM];\n\n' % (name, name),
+         '#ifdef __cplusplus\n}\n#endif\n\n#endif\n']
+    c = ['// Generated by tools/gen_trust_anchors.py, do not edit.\n\n',
+         '#include "%s"\n\n' % header]
+    c += [a + '\n' for a in arrays]
+    c.append('const br_x509_trust_anchor %s[%s_NUM] = {\n%s\n};\n' % (name, name, '\n'.join(entries)))
+    return ''.join(h), ''.join(c), len(blocks), len(entries)
+
+
+def main(argv):
+    args = [a for a in argv[1:] if not a.startswith('--')]
+    name = 'TAs'
+    if '--name' in argv:
+        name = argv[argv.index('--name') + 1]
+        args.remove(name)
+    if not args:
+        print('Usage: gen_trust_anchors.py <bundle.pem> [output] [--name TAs]')
+        return 1
+    base = os.path.splitext(args[1])[0] if len(args) > 1 else 'trust_anchors'
+    with open(args[0]) as f:
+        h, c, total, used = generate(f.read(), name, os.path.basename(base) + '.h')
+    with open(base + '.h', 'w') as f:
+        f.write(h)
+    with open(base + '.c', 'w') as f:
+        f.write(c)
+    sys.stderr.write('%d of %d certificates converted\n' % (used, total))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))